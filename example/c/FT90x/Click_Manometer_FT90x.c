@@ -17,7 +17,7 @@ Description :
 The application is composed of three sections :
 
 - System Initialization -  Initializes I2C structures.
-- Application Initialization - Initialization driver enable's - I2C and start write log to Usart Terminal.
+- Application Initialization - Initialization driver enable's - I2C, waits for the first valid sample and start write log to Usart Terminal.
 - Application Task - (code snippet) This is a example which demonstrates the use of Manometer Click board.
      Measured pressure ( mbar ) and temperature ( degrees Celsius ) from sensor,
      results are being sent to the Usart Terminal where you can track their changes.
@@ -35,20 +35,30 @@ Additional Functions :
 
 char textLog[10];
 float readData;
+uint16_t readyTime;
 
 void systemInit()
 {
     mikrobus_i2cInit( _MIKROBUS1, &_MANOMETER_I2C_CFG[0] );
     mikrobus_logInit( _MIKROBUS2, 9600 );
-    Delay_100ms();
 }
 
 void applicationInit()
 {
     manometer_i2cDriverInit( (T_MANOMETER_P)&_MIKROBUS1_GPIO, (T_MANOMETER_P)&_MIKROBUS1_I2C, _MANOMETER_I2C_ADDRESS );
     mikrobus_logWrite( "      Initialization", _LOG_LINE );
+    if ( manometer_waitReady( 100, &readyTime ) != _MANOMETER_OK )
+    {
+        mikrobus_logWrite( " Not ready, timeout", _LOG_LINE );
+    }
+    else
+    {
+        mikrobus_logWrite( " Ready after: ", _LOG_TEXT );
+        IntToStr( readyTime, textLog );
+        mikrobus_logWrite( textLog, _LOG_TEXT );
+        mikrobus_logWrite( " polls", _LOG_LINE );
+    }
     mikrobus_logWrite( "--------------------------", _LOG_LINE );
-    Delay_100ms();
 }
 
 void applicationTask()
@@ -0,0 +1,264 @@
+/*
+Example for Manometer Click
+
+    Date          : Sep 2018.
+    Author        : Nenad Filipovic
+
+Test configuration LINUX :
+
+    Platform         : Linux SBC with i2c-dev
+    Compiler         : gcc
+
+    gcc -I../../../library Click_Manometer_LINUX.c ../../../library/__manometer_driver.c
+
+---
+
+Description :
+
+The application is composed of three sections :
+
+- System Initialization -  Opens the i2c-dev bus.
+- Application Initialization - Initialization driver enable's - I2C and waits for the first valid sample.
+- Application Task - (code snippet) This is a example which demonstrates the use of Manometer Click board.
+     Measured pressure ( mbar ) and temperature ( degrees Celsius ) from sensor,
+     results are being sent to standard output for aproximetly every 2 sec.
+
+Started with "-b N" the application instead times N sample reads and
+prints latency and ioctl system calls per sample. Each read is one
+combined I2C_RDWR ioctl. Without an adapter, Click_Manometer_i2cstandin
+runs the same path against a user-space sensor model.
+
+Started with "-g A B N" the application reads sensors at addresses A and
+B as one synchronized group N times and prints the last differential
+in counts with the mean and worst skew between the two reads.
+
+Started with "-r N P" the application records N raw frames, one every
+P ms, to standard output for Click_Manometer_replay. A failed read is
+recorded as - and replays as a bus error.
+
+Built with -D__MANOMETER_TRACE__ and started with "-t N P" the
+application traces the bus during N sample reads, one every P ms, and
+dumps the events for Click_Manometer_tracejson:
+
+    Click_Manometer_LINUX -t 1000 5 | Click_Manometer_tracejson > trace.json
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "Click_Manometer_types.h"
+#include "Click_Manometer_config.h"
+#include "__HAL_LINUX.h"
+#include "__manometer_driver.h"
+
+T_hal_linuxBus i2cBus;
+float readData;
+uint16_t readyTime;
+
+void systemInit()
+{
+    i2cBus.fd = open( _MANOMETER_I2C_DEVICE, O_RDWR );
+    if ( i2cBus.fd < 0 )
+    {
+        perror( _MANOMETER_I2C_DEVICE );
+        exit( 1 );
+    }
+}
+
+uint32_t timeMs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( uint32_t )( ts.tv_sec * 1000UL + ts.tv_nsec / 1000000 );
+}
+
+void applicationInit()
+{
+    manometer_i2cDriverInit( (T_MANOMETER_P)0, (T_MANOMETER_P)&i2cBus, _MANOMETER_I2C_ADDRESS );
+    printf( "      Initialization\n" );
+    manometer_setTimeSource( timeMs );
+    if ( manometer_waitReady( 100, &readyTime ) != _MANOMETER_OK )
+        printf( " Not ready, timeout\n" );
+    else
+        printf( " Ready after: %u ms\n", readyTime );
+    manometer_setTimeSource( 0 );
+    printf( "--------------------------\n" );
+}
+
+void applicationTask()
+{
+    readData = manometer_getPressure();
+    printf( " Pressure:    %d mbar\n", (int)readData );
+
+    readData = manometer_getTemperature();
+    printf( " Temperature: %d C\n", (int)readData );
+    printf( "--------------------------\n" );
+
+    sleep( 2 );
+}
+
+void applicationBenchmark( long nSamples )
+{
+    T_MANOMETER_SAMPLE sample;
+    struct timespec t0, t1;
+    long cnt;
+    long errors = 0;
+    unsigned long nIoctl = i2cBus.nIoctl;
+    double elapsed;
+
+    clock_gettime( CLOCK_MONOTONIC, &t0 );
+    for ( cnt = 0; cnt < nSamples; cnt++ )
+    {
+        if ( manometer_readSample( &sample ) != _MANOMETER_OK )
+            errors++;
+    }
+    clock_gettime( CLOCK_MONOTONIC, &t1 );
+
+    elapsed = ( t1.tv_sec - t0.tv_sec ) * 1e6 + ( t1.tv_nsec - t0.tv_nsec ) / 1e3;
+    printf( " Samples:     %ld ( %ld errors )\n", nSamples, errors );
+    printf( " Latency:     %.1f us/sample\n", elapsed / nSamples );
+    printf( " Syscalls:    %.2f ioctl/sample\n", ( double )( i2cBus.nIoctl - nIoctl ) / nSamples );
+}
+
+uint32_t timeUs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( uint32_t )( ts.tv_sec * 1000000UL + ts.tv_nsec / 1000 );
+}
+
+void applicationGroup( uint8_t addrA, uint8_t addrB, long nReads )
+{
+    T_MANOMETER_SENSOR sensorA, sensorB;
+    T_MANOMETER_SENSOR *list[ 2 ] = { &sensorA, &sensorB };
+    T_MANOMETER_SAMPLE samples[ 2 ];
+    T_MANOMETER_GROUP group;
+    uint32_t offsets[ 2 ];
+    uint32_t skewMax = 0;
+    double skewSum = 0;
+    long cnt;
+    long errors = 0;
+
+    manometer_sensorInit( &sensorA, addrA );
+    manometer_sensorInit( &sensorB, addrB );
+    manometer_setTimeSource( timeUs );
+    manometer_groupInit( &group, list, samples, offsets, 2, 0 );
+
+    for ( cnt = 0; cnt < nReads; cnt++ )
+    {
+        if ( manometer_groupRead( &group ) != _MANOMETER_OK )
+        {
+            errors++;
+            continue;
+        }
+        skewSum += manometer_groupGetSkew( &group );
+        if ( manometer_groupGetSkew( &group ) > skewMax )
+            skewMax = manometer_groupGetSkew( &group );
+    }
+
+    printf( " Reads:        %ld ( %ld errors )\n", nReads, errors );
+    printf( " Differential: %d counts\n", manometer_groupGetDifferential( &group, 0, 1 ) );
+    if ( nReads > errors )
+        printf( " Skew:         %.1f us mean, %u us worst\n", skewSum / ( nReads - errors ), skewMax );
+}
+
+void applicationRecord( long nFrames, long period )
+{
+    struct timespec ts;
+    T_MANOMETER_SAMPLE sample;
+    unsigned long long time;
+    uint32_t frame;
+    uint8_t err;
+    long cnt;
+
+    for ( cnt = 0; cnt < nFrames; cnt++ )
+    {
+        err = manometer_readSample( &sample );
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        time = ( unsigned long long )ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+
+        // Frame is rebuilt from the decoded sample, a failed read is marked
+        if ( err == _MANOMETER_OK )
+        {
+            frame = ( ( uint32_t )sample.status << 30 ) | ( ( uint32_t )sample.pressure << 16 ) |
+                    ( ( uint32_t )sample.temperature << 5 );
+            printf( "%llu %08lX\n", time, ( unsigned long )frame );
+        }
+        else
+            printf( "%llu -\n", time );
+        usleep( period * 1000 );
+    }
+}
+
+#ifdef   __MANOMETER_TRACE__
+void applicationTrace( long nReads, long period )
+{
+    static T_MANOMETER_TRACE_EVENT events[ 4096 ];
+    T_MANOMETER_TRACE trace;
+    T_MANOMETER_TRACE_EVENT *event;
+    T_MANOMETER_SAMPLE sample;
+    uint16_t cnt;
+    long read;
+
+    manometer_setTimeSource( timeUs );
+    manometer_traceInit( &trace, events, 4096 );
+    for ( read = 0; read < nReads; read++ )
+    {
+        manometer_readSample( &sample );
+        usleep( period * 1000 );
+    }
+    manometer_traceStop();
+
+    printf( "# %u events, %u lost\n", manometer_traceGetCount( &trace ), manometer_traceGetLost( &trace ) );
+    for ( cnt = 0; cnt < manometer_traceGetCount( &trace ); cnt++ )
+    {
+        event = manometer_traceGetEvent( &trace, cnt );
+        printf( "%u %u %u %u %d\n", event->time, event->kind, event->address, event->nBytes, event->result );
+    }
+}
+#endif
+
+int main( int argc, char **argv )
+{
+    systemInit();
+    applicationInit();
+
+    if ( ( argc > 2 ) && ( strcmp( argv[ 1 ], "-b" ) == 0 ) )
+    {
+        applicationBenchmark( atol( argv[ 2 ] ) );
+        return 0;
+    }
+    if ( ( argc > 3 ) && ( strcmp( argv[ 1 ], "-r" ) == 0 ) )
+    {
+        applicationRecord( atol( argv[ 2 ] ), atol( argv[ 3 ] ) );
+        return 0;
+    }
+#ifdef   __MANOMETER_TRACE__
+    if ( ( argc > 3 ) && ( strcmp( argv[ 1 ], "-t" ) == 0 ) )
+    {
+        applicationTrace( atol( argv[ 2 ] ), atol( argv[ 3 ] ) );
+        return 0;
+    }
+#endif
+    if ( ( argc > 4 ) && ( strcmp( argv[ 1 ], "-g" ) == 0 ) )
+    {
+        applicationGroup( strtol( argv[ 2 ], NULL, 0 ), strtol( argv[ 3 ], NULL, 0 ), atol( argv[ 4 ] ) );
+        return 0;
+    }
+
+    while (1)
+    {
+            applicationTask();
+    }
+}
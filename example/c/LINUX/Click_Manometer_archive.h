@@ -0,0 +1,222 @@
+/*
+Columnar sample archive for Manometer Click
+
+Samples are stored in fixed-size segment files that are used directly
+through mmap. A segment holds fixed-width columns and a sparse index:
+
+    header | time[ cap ] u64 | pressure[ cap ] u16 | temperature[ cap ] u16 |
+    status[ cap ] u8 | index[ cap / ARCHIVE_INDEX_STRIDE ] u64
+
+Timestamps are nanoseconds since the Unix epoch ( UTC ) and
+non-decreasing within an archive. The sparse index holds
+every ARCHIVE_INDEX_STRIDE-th timestamp, so a range query is a binary
+search over the index followed by a sequential column scan. Nothing is
+parsed. Segment headers carry the first and last timestamp, so whole
+segments outside the range are skipped without touching their columns.
+Segment files are named by their first timestamp and sort by time,
+also across restarts of the writer.
+
+    Writer : archive_writerOpen(), archive_writerAppend(), archive_writerClose()
+    Reader : archive_segmentOpen(), archive_segmentFind(), archive_segmentClose()
+*/
+
+#ifndef _CLICK_MANOMETER_ARCHIVE_H_
+#define _CLICK_MANOMETER_ARCHIVE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "__manometer_driver.h"
+
+#define ARCHIVE_MAGIC           0x4D434131UL
+#define ARCHIVE_SEGMENT_CAP     1048576UL
+#define ARCHIVE_INDEX_STRIDE    256UL
+#define ARCHIVE_PATH_MAX        512
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t stride;
+    uint64_t firstTime;
+    uint64_t lastTime;
+
+}T_archive_header;
+
+typedef struct
+{
+    T_archive_header *hdr;
+    uint64_t         *time;
+    uint16_t         *pressure;
+    uint16_t         *temperature;
+    uint8_t          *status;
+    uint64_t         *index;
+    size_t           size;
+
+}T_archive_segment;
+
+typedef struct
+{
+    char              dir[ ARCHIVE_PATH_MAX ];
+    T_archive_segment seg;
+    int               open;
+
+}T_archive_writer;
+
+static inline size_t archive_segmentSize( uint32_t cap )
+{
+    return sizeof( T_archive_header ) + ( size_t )cap * ( 8 + 2 + 2 + 1 ) + ( cap / ARCHIVE_INDEX_STRIDE ) * 8;
+}
+
+static inline void archive_segmentBind( T_archive_segment *seg, uint8_t *base, uint32_t cap )
+{
+    seg->hdr = ( T_archive_header* )base;
+    base += sizeof( T_archive_header );
+    seg->time = ( uint64_t* )base;
+    base += ( size_t )cap * 8;
+    seg->pressure = ( uint16_t* )base;
+    base += ( size_t )cap * 2;
+    seg->temperature = ( uint16_t* )base;
+    base += ( size_t )cap * 2;
+    seg->status = base;
+    base += cap;
+    seg->index = ( uint64_t* )base;
+}
+
+/* Maps an existing segment read-only */
+static inline int archive_segmentOpen( T_archive_segment *seg, const char *path )
+{
+    T_archive_header hdr;
+    uint8_t *base;
+    int fd;
+
+    fd = open( path, O_RDONLY );
+    if ( fd < 0 )
+        return -1;
+    if ( pread( fd, &hdr, sizeof( hdr ), 0 ) != ( ssize_t )sizeof( hdr ) || hdr.magic != ARCHIVE_MAGIC )
+    {
+        close( fd );
+        return -1;
+    }
+    seg->size = archive_segmentSize( hdr.capacity );
+    base = ( uint8_t* )mmap( NULL, seg->size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( base == MAP_FAILED )
+        return -1;
+    archive_segmentBind( seg, base, hdr.capacity );
+
+    return 0;
+}
+
+static inline void archive_segmentClose( T_archive_segment *seg )
+{
+    munmap( seg->hdr, seg->size );
+}
+
+/* Returns position of the first sample with time >= t ( count if none ) */
+static inline uint32_t archive_segmentFind( T_archive_segment *seg, uint64_t t )
+{
+    uint32_t count = seg->hdr->count;
+    uint32_t lo = 0;
+    uint32_t hi = ( count + seg->hdr->stride - 1 ) / seg->hdr->stride;
+    uint32_t mid;
+    uint32_t pos;
+
+    while ( lo < hi )
+    {
+        mid = ( lo + hi ) / 2;
+        if ( seg->index[ mid ] < t )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    pos = ( lo > 0 ) ? ( lo - 1 ) * seg->hdr->stride : 0;
+    while ( ( pos < count ) && ( seg->time[ pos ] < t ) )
+        pos++;
+
+    return pos;
+}
+
+static inline int archive_writerSegment( T_archive_writer *w, uint64_t firstTime )
+{
+    char path[ ARCHIVE_PATH_MAX + 32 ];
+    uint8_t *base;
+    int fd;
+
+    snprintf( path, sizeof( path ), "%s/%020llu.mca", w->dir, ( unsigned long long )firstTime );
+    fd = open( path, O_CREAT | O_TRUNC | O_RDWR, 0644 );
+    if ( fd < 0 )
+        return -1;
+    w->seg.size = archive_segmentSize( ARCHIVE_SEGMENT_CAP );
+    if ( ftruncate( fd, w->seg.size ) != 0 )
+    {
+        close( fd );
+        return -1;
+    }
+    base = ( uint8_t* )mmap( NULL, w->seg.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( base == MAP_FAILED )
+        return -1;
+
+    archive_segmentBind( &w->seg, base, ARCHIVE_SEGMENT_CAP );
+    w->seg.hdr->capacity = ARCHIVE_SEGMENT_CAP;
+    w->seg.hdr->stride = ARCHIVE_INDEX_STRIDE;
+    w->seg.hdr->count = 0;
+    w->seg.hdr->firstTime = firstTime;
+    w->seg.hdr->magic = ARCHIVE_MAGIC;
+    w->open = 1;
+
+    return 0;
+}
+
+static inline int archive_writerOpen( T_archive_writer *w, const char *dir )
+{
+    snprintf( w->dir, sizeof( w->dir ), "%s", dir );
+    mkdir( dir, 0755 );
+    w->open = 0;
+
+    return 0;
+}
+
+static inline void archive_writerClose( T_archive_writer *w )
+{
+    if ( !w->open )
+        return;
+    msync( w->seg.hdr, w->seg.size, MS_ASYNC );
+    archive_segmentClose( &w->seg );
+    w->open = 0;
+}
+
+/* Appends one driver sample; time must not decrease */
+static inline int archive_writerAppend( T_archive_writer *w, uint64_t time, T_MANOMETER_SAMPLE *sample )
+{
+    T_archive_header *hdr;
+    uint32_t pos;
+
+    if ( w->open && ( w->seg.hdr->count >= w->seg.hdr->capacity ) )
+        archive_writerClose( w );
+    if ( !w->open && ( archive_writerSegment( w, time ) != 0 ) )
+        return -1;
+
+    hdr = w->seg.hdr;
+    pos = hdr->count;
+    w->seg.time[ pos ] = time;
+    w->seg.pressure[ pos ] = sample->pressure;
+    w->seg.temperature[ pos ] = sample->temperature;
+    w->seg.status[ pos ] = sample->status;
+    if ( ( pos % ARCHIVE_INDEX_STRIDE ) == 0 )
+        w->seg.index[ pos / ARCHIVE_INDEX_STRIDE ] = time;
+    hdr->lastTime = time;
+    hdr->count = pos + 1;
+
+    return 0;
+}
+
+#endif
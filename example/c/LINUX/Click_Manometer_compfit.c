@@ -0,0 +1,177 @@
+/*
+Temperature compensation fit for Manometer Click
+
+    gcc -O2 Click_Manometer_compfit.c -o Click_Manometer_compfit -lm
+
+---
+
+Description :
+
+Fits the per-device coefficients of the driver compensation model
+( manometer_compInit(), manometer_compApply() ):
+
+    p' = p + offset( x ) + ( p - 8192 ) * gain( x ),   x = ( t - tRef ) / 2048
+
+with quadratic offset and gain, by least squares over recorded samples
+taken against a reference. Prints the residual before and after, and
+the fixed-point coefficients ( offset Q16, gain Q24 ) ready to paste
+into the application.
+
+Usage :
+
+    Click_Manometer_compfit [-r tRef] < recording
+
+Recording has one sample per line, all values in raw counts:
+
+    <pressure count> <temperature count> <reference pressure count>
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+
+#define FIT_TERMS       6
+#define FIT_SAMPLES_MAX 1000000
+
+static double pressure[ FIT_SAMPLES_MAX ];
+static double temperature[ FIT_SAMPLES_MAX ];
+static double reference[ FIT_SAMPLES_MAX ];
+
+static void basis( double p, double t, double tRef, double *row )
+{
+    double x = ( t - tRef ) / 2048.0;
+    double d = p - 8192.0;
+
+    row[ 0 ] = 1.0;
+    row[ 1 ] = x;
+    row[ 2 ] = x * x;
+    row[ 3 ] = d;
+    row[ 4 ] = d * x;
+    row[ 5 ] = d * x * x;
+}
+
+/* Solves a * c = b in place by Gaussian elimination with partial pivoting */
+static int solve( double a[ FIT_TERMS ][ FIT_TERMS ], double *b, double *c )
+{
+    double factor, tmp;
+    int i, j, k, pivot;
+
+    for ( i = 0; i < FIT_TERMS; i++ )
+    {
+        pivot = i;
+        for ( j = i + 1; j < FIT_TERMS; j++ )
+            if ( fabs( a[ j ][ i ] ) > fabs( a[ pivot ][ i ] ) )
+                pivot = j;
+        if ( fabs( a[ pivot ][ i ] ) < 1e-12 )
+            return -1;
+        for ( k = 0; k < FIT_TERMS; k++ )
+        {
+            tmp = a[ i ][ k ];
+            a[ i ][ k ] = a[ pivot ][ k ];
+            a[ pivot ][ k ] = tmp;
+        }
+        tmp = b[ i ];
+        b[ i ] = b[ pivot ];
+        b[ pivot ] = tmp;
+
+        for ( j = i + 1; j < FIT_TERMS; j++ )
+        {
+            factor = a[ j ][ i ] / a[ i ][ i ];
+            for ( k = i; k < FIT_TERMS; k++ )
+                a[ j ][ k ] -= factor * a[ i ][ k ];
+            b[ j ] -= factor * b[ i ];
+        }
+    }
+
+    for ( i = FIT_TERMS - 1; i >= 0; i-- )
+    {
+        c[ i ] = b[ i ];
+        for ( k = i + 1; k < FIT_TERMS; k++ )
+            c[ i ] -= a[ i ][ k ] * c[ k ];
+        c[ i ] /= a[ i ][ i ];
+    }
+
+    return 0;
+}
+
+int main( int argc, char **argv )
+{
+    double ata[ FIT_TERMS ][ FIT_TERMS ] = { { 0 } };
+    double atb[ FIT_TERMS ] = { 0 };
+    double coeff[ FIT_TERMS ];
+    double row[ FIT_TERMS ];
+    double tRef = -1.0;
+    double tSum = 0.0;
+    double err, errBefore = 0.0, errAfter = 0.0;
+    long fixed[ FIT_TERMS ];
+    long n = 0;
+    long i;
+    int opt;
+    int j, k;
+
+    while ( ( opt = getopt( argc, argv, "r:" ) ) != -1 )
+    {
+        if ( opt != 'r' )
+        {
+            fprintf( stderr, "usage: %s [-r tRef] < recording\n", argv[ 0 ] );
+            return 1;
+        }
+        tRef = atof( optarg );
+    }
+
+    while ( ( n < FIT_SAMPLES_MAX ) &&
+            ( scanf( "%lf %lf %lf", &pressure[ n ], &temperature[ n ], &reference[ n ] ) == 3 ) )
+        tSum += temperature[ n++ ];
+    if ( n < FIT_TERMS )
+    {
+        fprintf( stderr, "need at least %d samples\n", FIT_TERMS );
+        return 1;
+    }
+    if ( tRef < 0.0 )
+        tRef = floor( tSum / n + 0.5 );
+
+    for ( i = 0; i < n; i++ )
+    {
+        basis( pressure[ i ], temperature[ i ], tRef, row );
+        for ( j = 0; j < FIT_TERMS; j++ )
+        {
+            for ( k = 0; k < FIT_TERMS; k++ )
+                ata[ j ][ k ] += row[ j ] * row[ k ];
+            atb[ j ] += row[ j ] * ( reference[ i ] - pressure[ i ] );
+        }
+    }
+    if ( solve( ata, atb, coeff ) != 0 )
+    {
+        fprintf( stderr, "recording does not span enough pressure and temperature\n" );
+        return 1;
+    }
+
+    for ( i = 0; i < n; i++ )
+    {
+        basis( pressure[ i ], temperature[ i ], tRef, row );
+        err = reference[ i ] - pressure[ i ];
+        errBefore += err * err;
+        for ( j = 0; j < FIT_TERMS; j++ )
+            err -= coeff[ j ] * row[ j ];
+        errAfter += err * err;
+    }
+
+    for ( j = 0; j < FIT_TERMS; j++ )
+    {
+        fixed[ j ] = lround( coeff[ j ] * ( ( j < 3 ) ? 65536.0 : 16777216.0 ) );
+        if ( labs( fixed[ j ] ) >= ( 1L << 30 ) )
+            fprintf( stderr, "warning: coefficient %d out of range\n", j );
+    }
+
+    printf( "// %ld samples, rms error %.3f counts before, %.3f counts after\n",
+            n, sqrt( errBefore / n ), sqrt( errAfter / n ) );
+    printf( "int32_t compOffset[ 3 ] = { %ld, %ld, %ld };\n", fixed[ 0 ], fixed[ 1 ], fixed[ 2 ] );
+    printf( "int32_t compGain[ 3 ]   = { %ld, %ld, %ld };\n", fixed[ 3 ], fixed[ 4 ], fixed[ 5 ] );
+    printf( "manometer_compInit( &comp, %.0f, compOffset, compGain );\n", tRef );
+
+    return 0;
+}
@@ -0,0 +1,4 @@
+#include "Click_Manometer_types.h"
+
+
+const char _MANOMETER_I2C_DEVICE[] = "/dev/i2c-1";
@@ -0,0 +1,102 @@
+/*
+Count conversion benchmark for Manometer Click
+
+    gcc -O2 -I../../../library Click_Manometer_convbench.c ../../../library/__manometer_driver.c -o convbench_arith
+    gcc -O2 -D__MANOMETER_LUT__ -I../../../library Click_Manometer_convbench.c ../../../library/__manometer_driver.c -o convbench_lut
+
+---
+
+Description :
+
+Times the driver count conversions over every possible count, as
+built: arithmetic by default, table interpolation with __MANOMETER_LUT__.
+Build both and compare. The largest deviation from the exact double
+precision conversion is reported next to the rate.
+
+Usage :
+
+    Click_Manometer_convbench [passes]
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "__manometer_driver.h"
+
+static double nowSec()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void report( const char *name, double elapsed, unsigned long n )
+{
+    printf( "%-20s %8.2f ns/conversion\n", name, elapsed * 1e9 / n );
+}
+
+int main( int argc, char **argv )
+{
+    unsigned long passes = ( argc > 1 ) ? strtoul( argv[ 1 ], NULL, 0 ) : 1000;
+    volatile float sinkF = 0;
+    volatile int32_t sinkI = 0;
+    double maxErr;
+    double err;
+    double t0;
+    unsigned long p;
+    uint16_t count;
+
+#ifdef __MANOMETER_LUT__
+    printf( "conversion mode: table\n" );
+#else
+    printf( "conversion mode: arithmetic\n" );
+#endif
+
+    t0 = nowSec();
+    for ( p = 0; p < passes; p++ )
+        for ( count = 0; count < 16384; count++ )
+            sinkF += manometer_countToPressure( count );
+    report( "countToPressure", nowSec() - t0, passes * 16384UL );
+
+    t0 = nowSec();
+    for ( p = 0; p < passes; p++ )
+        for ( count = 0; count < 16384; count++ )
+            sinkI += manometer_countToPascal( count );
+    report( "countToPascal", nowSec() - t0, passes * 16384UL );
+
+    t0 = nowSec();
+    for ( p = 0; p < passes; p++ )
+        for ( count = 0; count < 2048; count++ )
+            sinkF += manometer_countToTemperature( count );
+    report( "countToTemperature", nowSec() - t0, passes * 2048UL );
+
+    maxErr = 0;
+    for ( count = 0; count < 16384; count++ )
+    {
+        err = manometer_countToPressure( count ) - ( count - 1638.0 ) * 4177.0 / 13107.0;
+        if ( err < 0 )
+            err = -err;
+        if ( err > maxErr )
+            maxErr = err;
+    }
+    printf( "pressure    max error %.4f mbar\n", maxErr );
+
+    maxErr = 0;
+    for ( count = 0; count < 2048; count++ )
+    {
+        err = manometer_countToTemperature( count ) - ( count * 200.0 / 2047.0 - 50.0 );
+        if ( err < 0 )
+            err = -err;
+        if ( err > maxErr )
+            maxErr = err;
+    }
+    printf( "temperature max error %.4f degC\n", maxErr );
+
+    return 0;
+}
@@ -0,0 +1,463 @@
+/*
+Multi-sensor acquisition daemon for Manometer Click
+
+    Platform         : Linux SBC with i2c-dev
+    Compiler         : gcc
+
+    gcc -I../../../library Click_Manometer_daemon.c ../../../library/__manometer_driver.c
+    gcc -D__HAL_SIM__ -I../../../library Click_Manometer_daemon.c ../../../library/__manometer_driver.c -o Click_Manometer_daemon_sim
+
+---
+
+Description :
+
+One thread serves every sensor on the bus. Each sensor has its own read
+period; deadlines are kept in a min-heap and a single timerfd is armed
+for the earliest one. When it fires, every sensor due within the
+coalescing window is read back to back, so sensors with equal or
+harmonic periods share one wakeup. Deadlines follow the monotonic clock;
+samples are stamped with UTC wall-clock time.
+
+Usage :
+
+    Click_Manometer_daemon [-s shm-name] [-a archive-dir] [-t seconds] <i2c-device> <sensor-list>
+
+Sensor list has one sensor per line: 7-bit address and period in ms,
+optionally followed by the multiplexer address and channel the sensor
+sits behind.
+
+    0x28 100
+    0x38 1000
+    0x28 1000 0x70 3
+
+Samples are written to standard output as:
+
+    <time ms> <address> <status> <pressure count> <temperature count>
+
+with time in ms since the Unix epoch ( UTC ), and where the address of a sensor behind a multiplexer reads
+<address>@<mux>.<channel>.
+
+With -t the daemon stops after the given time. On exit it reports to
+standard error the reads, read errors, wakeups, sensors that missed a
+whole period and the CPU time used.
+
+Built with __HAL_SIM__ the bus is simulated ( __HAL_SIM.h ) and the
+i2c-device argument is left out. Every listed sensor answers, behind
+TCA9548A-style multiplexers at their addresses, and a sensor address
+present on the main bus and on an enabled channel at the same time
+fails as a bus conflict. Wakeups and reads run in real time while bus
+time is only counted, so the exit report adds how busy the simulated
+400 kHz bus was; above 100 % a real bus could not keep up with the
+list. A list of 1024 sensors, 16 per channel on 8 multiplexers:
+
+    awk 'BEGIN { for ( i = 0; i < 1024; i++ ) printf "0x%02X 1000 0x%02X %d\n", 40 + i % 16, 112 + int( i / 128 ), int( i / 16 ) % 8 }' > sensors.txt
+    Click_Manometer_daemon_sim -t 10 sensors.txt > /dev/null
+
+With -s, samples are published to the shared-memory sample bus
+( Click_Manometer_shm.h ) instead, for any number of local readers; each
+slot carries the sensor address with its multiplexer address and channel.
+With -a, samples are also appended to a columnar archive
+( Click_Manometer_archive.h ), one sub-directory per sensor address.
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+
+#ifdef   __HAL_SIM__
+#include "__HAL_SIM.h"
+#else
+#include "__HAL_LINUX.h"
+#endif
+#include "__manometer_driver.h"
+#include "Click_Manometer_shm.h"
+#include "Click_Manometer_archive.h"
+
+#define DAEMON_SENSORS_MAX      4096
+#define DAEMON_COALESCE_NS      500000ULL
+#define DAEMON_SHM_CAPACITY     65536
+#define DAEMON_SIM_SPEED        400000
+
+typedef struct
+{
+    T_MANOMETER_SENSOR sensor;
+    uint64_t           periodNs;
+    uint64_t           deadline;
+    T_archive_writer   archive;
+
+}T_daemon_sensor;
+
+#ifdef   __HAL_SIM__
+static T_hal_simBus    i2cBus;
+static uint8_t         simPresent[ 9 * 8 ][ 128 ];
+static uint8_t         simMux[ 8 ];
+static unsigned long   simConflicts;
+#else
+static T_hal_linuxBus  i2cBus;
+#endif
+static T_daemon_sensor sensors[ DAEMON_SENSORS_MAX ];
+static uint16_t        heap[ DAEMON_SENSORS_MAX ];
+static uint16_t        nSensors = 0;
+static T_shm_bus       shmBus;
+static int             shmEnabled = 0;
+static const char      *archiveDir = NULL;
+static unsigned long   nReads, nErrors, nWakeups, nLate;
+static uint64_t        lastStamp = 0;
+
+static uint64_t nowNs()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ( uint64_t )ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Sample timestamp: UTC, held when the wall clock steps back so archives stay ordered */
+static uint64_t stampNs()
+{
+    struct timespec ts;
+    uint64_t stamp;
+
+    clock_gettime( CLOCK_REALTIME, &ts );
+    stamp = ( uint64_t )ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    if ( stamp < lastStamp )
+        stamp = lastStamp;
+    lastStamp = stamp;
+
+    return stamp;
+}
+
+#ifdef   __HAL_SIM__
+/* Sensors answer on the main bus ( index 0 ) or on an enabled multiplexer channel */
+static int simDevice( void *context, uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t isRead )
+{
+    uint16_t pressure;
+    uint8_t hits = 0;
+    uint8_t m, c;
+
+    (void)context;
+    if ( ( slaveAddress & 0xF8 ) == 0x70 )
+    {
+        if ( !isRead && ( nBytes == 1 ) )
+            simMux[ slaveAddress & 0x07 ] = pBuf[ 0 ];
+        return 0;
+    }
+
+    if ( simPresent[ 0 ][ slaveAddress & 0x7F ] )
+        hits++;
+    for ( m = 0; m < 8; m++ )
+        for ( c = 0; c < 8; c++ )
+            if ( ( simMux[ m ] & ( 1 << c ) ) && simPresent[ 1 + m * 8 + c ][ slaveAddress & 0x7F ] )
+                hits++;
+    if ( hits != 1 )
+    {
+        if ( hits > 1 )
+            simConflicts++;
+        return -1;
+    }
+
+    if ( isRead )
+    {
+        pressure = 8192 + ( slaveAddress & 0x0F ) * 16 + ( i2cBus.time / 1000000ULL ) % 16;
+        memset( pBuf, 0, nBytes );
+        if ( nBytes > 0 )
+            pBuf[ 0 ] = pressure >> 8;
+        if ( nBytes > 1 )
+            pBuf[ 1 ] = pressure & 0xFF;
+        if ( nBytes > 2 )
+            pBuf[ 2 ] = 0x66;
+    }
+
+    return 0;
+}
+#endif
+
+/* Earlier deadline first, equal deadlines in list order to keep multiplexer switches low */
+static int heapBefore( uint16_t a, uint16_t b )
+{
+    if ( sensors[ a ].deadline != sensors[ b ].deadline )
+        return sensors[ a ].deadline < sensors[ b ].deadline;
+
+    return a < b;
+}
+
+static void heapSwap( uint16_t a, uint16_t b )
+{
+    uint16_t tmp = heap[ a ];
+
+    heap[ a ] = heap[ b ];
+    heap[ b ] = tmp;
+}
+
+static void heapDown( uint16_t pos )
+{
+    uint16_t child;
+
+    for ( ;; )
+    {
+        child = 2 * pos + 1;
+        if ( child >= nSensors )
+            return;
+        if ( ( child + 1 < nSensors ) && heapBefore( heap[ child + 1 ], heap[ child ] ) )
+            child++;
+        if ( !heapBefore( heap[ child ], heap[ pos ] ) )
+            return;
+        heapSwap( pos, child );
+        pos = child;
+    }
+}
+
+static void heapUp( uint16_t pos )
+{
+    uint16_t parent;
+
+    while ( pos > 0 )
+    {
+        parent = ( pos - 1 ) / 2;
+        if ( !heapBefore( heap[ pos ], heap[ parent ] ) )
+            return;
+        heapSwap( pos, parent );
+        pos = parent;
+    }
+}
+
+static int loadSensors( const char *path )
+{
+    FILE *f;
+    char line[ 128 ];
+    unsigned int addr, period;
+    unsigned int mux, channel;
+    int n;
+    uint64_t start = nowNs();
+    char dir[ ARCHIVE_PATH_MAX ];
+
+    f = fopen( path, "r" );
+    if ( f == NULL )
+        return -1;
+
+    while ( ( nSensors < DAEMON_SENSORS_MAX ) && ( fgets( line, sizeof( line ), f ) != NULL ) )
+    {
+        n = sscanf( line, "%i %u %i %u", &addr, &period, &mux, &channel );
+        if ( n < 2 )
+            continue;
+        if ( n < 4 )
+            mux = 0;
+
+        manometer_sensorInit( &sensors[ nSensors ].sensor, ( uint8_t )addr );
+        if ( mux != 0 )
+            manometer_sensorSetMux( &sensors[ nSensors ].sensor, ( uint8_t )mux, ( uint8_t )channel );
+        sensors[ nSensors ].periodNs = ( uint64_t )( period ? period : 1 ) * 1000000ULL;
+        sensors[ nSensors ].deadline = start;
+#ifdef   __HAL_SIM__
+        simPresent[ ( mux != 0 ) ? 1 + ( mux & 0x07 ) * 8 + ( channel & 0x07 ) : 0 ][ addr & 0x7F ] = 1;
+#endif
+        if ( archiveDir != NULL )
+        {
+            if ( mux != 0 )
+                snprintf( dir, sizeof( dir ), "%s/0x%02X@0x%02X.%u", archiveDir, addr, mux, channel & 0x07 );
+            else
+                snprintf( dir, sizeof( dir ), "%s/0x%02X", archiveDir, addr );
+            archive_writerOpen( &sensors[ nSensors ].archive, dir );
+        }
+        heap[ nSensors ] = nSensors;
+        heapUp( nSensors++ );
+    }
+    fclose( f );
+
+    return 0;
+}
+
+static void armTimer( int tfd )
+{
+    struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+    uint64_t deadline = sensors[ heap[ 0 ] ].deadline;
+
+    its.it_value.tv_sec = deadline / 1000000000ULL;
+    its.it_value.tv_nsec = deadline % 1000000000ULL;
+    timerfd_settime( tfd, TFD_TIMER_ABSTIME, &its, NULL );
+}
+
+static void serviceDue()
+{
+    T_MANOMETER_SAMPLE sample;
+    T_daemon_sensor *s;
+    uint64_t now = nowNs();
+    uint64_t stamp;
+
+    nWakeups++;
+    while ( sensors[ heap[ 0 ] ].deadline <= now + DAEMON_COALESCE_NS )
+    {
+        s = &sensors[ heap[ 0 ] ];
+
+        nReads++;
+        if ( ( manometer_selectSensor( &s->sensor ) == _MANOMETER_OK ) &&
+             ( manometer_readSample( &sample ) == _MANOMETER_OK ) )
+        {
+            stamp = stampNs();
+            if ( archiveDir != NULL )
+                archive_writerAppend( &s->archive, stamp, &sample );
+            if ( shmEnabled )
+                shm_busPublish( &shmBus, stamp, s->sensor.slaveAddress, s->sensor.muxAddress,
+                                s->sensor.muxChannel, sample.status, sample.pressure, sample.temperature );
+            else if ( s->sensor.muxAddress != 0 )
+                printf( "%llu 0x%02X@0x%02X.%u %u %u %u\n", ( unsigned long long )( stamp / 1000000ULL ),
+                        s->sensor.slaveAddress, s->sensor.muxAddress, s->sensor.muxChannel,
+                        sample.status, sample.pressure, sample.temperature );
+            else
+                printf( "%llu 0x%02X %u %u %u\n", ( unsigned long long )( stamp / 1000000ULL ),
+                        s->sensor.slaveAddress, sample.status, sample.pressure, sample.temperature );
+        }
+        else
+            nErrors++;
+
+        s->deadline += s->periodNs;
+        if ( s->deadline < now )
+        {
+            nLate++;
+            s->deadline = now + s->periodNs;
+        }
+        heapDown( 0 );
+    }
+    fflush( stdout );
+}
+
+int main( int argc, char **argv )
+{
+    struct epoll_event ev;
+    sigset_t mask;
+    uint64_t expirations;
+    uint64_t start, stop = 0;
+    struct timespec cpu;
+    const char *shmName = NULL;
+    const char *listPath;
+    double elapsed;
+    int efd, tfd, sfd;
+    int opt;
+    uint16_t i;
+
+    while ( ( opt = getopt( argc, argv, "s:a:t:" ) ) != -1 )
+    {
+        if ( opt == 's' )
+            shmName = optarg;
+        else if ( opt == 'a' )
+            archiveDir = optarg;
+        else if ( opt == 't' )
+            stop = ( uint64_t )atol( optarg ) * 1000000000ULL;
+        else
+            optind = argc;
+    }
+#ifdef   __HAL_SIM__
+    if ( argc - optind < 1 )
+    {
+        fprintf( stderr, "usage: %s [-s shm-name] [-a archive-dir] [-t seconds] <sensor-list>\n", argv[ 0 ] );
+        return 1;
+    }
+    listPath = argv[ optind ];
+
+    i2cBus.device = simDevice;
+    i2cBus.speed = DAEMON_SIM_SPEED;
+#else
+    if ( argc - optind < 2 )
+    {
+        fprintf( stderr, "usage: %s [-s shm-name] [-a archive-dir] [-t seconds] <i2c-device> <sensor-list>\n", argv[ 0 ] );
+        return 1;
+    }
+    listPath = argv[ optind + 1 ];
+
+    i2cBus.fd = open( argv[ optind ], O_RDWR );
+    if ( i2cBus.fd < 0 )
+    {
+        perror( argv[ optind ] );
+        return 1;
+    }
+#endif
+    if ( archiveDir != NULL )
+        mkdir( archiveDir, 0755 );
+    if ( ( loadSensors( listPath ) != 0 ) || ( nSensors == 0 ) )
+    {
+        fprintf( stderr, "%s: no sensors\n", listPath );
+        return 1;
+    }
+    if ( shmName != NULL )
+    {
+        if ( shm_busCreate( &shmBus, shmName, DAEMON_SHM_CAPACITY ) != 0 )
+        {
+            perror( shmName );
+            return 1;
+        }
+        shmEnabled = 1;
+    }
+    manometer_i2cDriverInit( (T_MANOMETER_P)0, (T_MANOMETER_P)&i2cBus, sensors[ 0 ].sensor.slaveAddress );
+
+    sigemptyset( &mask );
+    sigaddset( &mask, SIGINT );
+    sigaddset( &mask, SIGTERM );
+    sigprocmask( SIG_BLOCK, &mask, NULL );
+
+    efd = epoll_create1( 0 );
+    tfd = timerfd_create( CLOCK_MONOTONIC, 0 );
+    sfd = signalfd( -1, &mask, 0 );
+
+    ev.events = EPOLLIN;
+    ev.data.fd = tfd;
+    epoll_ctl( efd, EPOLL_CTL_ADD, tfd, &ev );
+    ev.data.fd = sfd;
+    epoll_ctl( efd, EPOLL_CTL_ADD, sfd, &ev );
+
+    armTimer( tfd );
+    start = nowNs();
+    if ( stop != 0 )
+        stop += start;
+
+    for ( ;; )
+    {
+        if ( epoll_wait( efd, &ev, 1, -1 ) <= 0 )
+            continue;
+        if ( ev.data.fd == sfd )
+            break;
+
+        read( tfd, &expirations, sizeof( expirations ) );
+        serviceDue();
+        if ( ( stop != 0 ) && ( nowNs() >= stop ) )
+            break;
+        armTimer( tfd );
+    }
+
+    elapsed = ( nowNs() - start ) / 1e9;
+    clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &cpu );
+    fprintf( stderr, "sensors   %u\n", nSensors );
+    fprintf( stderr, "reads     %lu ( %lu errors ), %.0f /s\n", nReads, nErrors, nReads / elapsed );
+    fprintf( stderr, "wakeups   %lu, %.1f reads per wakeup\n", nWakeups, nWakeups ? ( double )nReads / nWakeups : 0.0 );
+    fprintf( stderr, "late      %lu reads missed a whole period\n", nLate );
+    fprintf( stderr, "cpu       %.1f %% ( %.2f us per read )\n", ( cpu.tv_sec + cpu.tv_nsec / 1e9 ) / elapsed * 100.0,
+             nReads ? ( cpu.tv_sec * 1e6 + cpu.tv_nsec / 1e3 ) / nReads : 0.0 );
+#ifdef   __HAL_SIM__
+    fprintf( stderr, "bus       %.1f %% busy at %u kHz, %lu starts, %lu conflicts\n",
+             i2cBus.time / 1e9 / elapsed * 100.0, DAEMON_SIM_SPEED / 1000, i2cBus.nStart, simConflicts );
+#endif
+
+    if ( archiveDir != NULL )
+        for ( i = 0; i < nSensors; i++ )
+            archive_writerClose( &sensors[ i ].archive );
+
+    close( sfd );
+    close( tfd );
+    close( efd );
+#ifndef  __HAL_SIM__
+    close( i2cBus.fd );
+#endif
+
+    return 0;
+}
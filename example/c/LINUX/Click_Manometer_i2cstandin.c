@@ -0,0 +1,223 @@
+/*
+User-space i2c-dev stand-in for Manometer Click
+
+    gcc -O2 -I../../../library Click_Manometer_i2cstandin.c ../../../library/__manometer_driver.c -o Click_Manometer_i2cstandin
+
+---
+
+Description :
+
+Tests the Linux HAL backend ( __HAL_LINUX.c ) without an adapter. The
+kernel i2c-stub module emulates SMBus transfers only and rejects the
+I2C_RDWR ioctl the backend uses, so this program replaces ioctl()
+instead: I2C_RDWR on its own descriptor is answered by a sensor model at
+0x28, every other call goes to the kernel unchanged.
+
+Checked for each driver call are the number of ioctl calls, the message
+layout ( address, direction, length, bytes written ), the decoded result
+over every pressure count, a missing sensor reported as bus error and
+the ioctl count kept in the bus object. The sample read is then timed.
+Exit status is 0 when every check passes.
+
+Usage :
+
+    Click_Manometer_i2cstandin [samples]
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "__HAL_LINUX.h"
+#include "__manometer_driver.h"
+
+#define STANDIN_ADDRESS     0x28
+#define STANDIN_MSGS_MAX    4
+
+typedef struct
+{
+    uint16_t addr;
+    uint16_t flags;
+    uint16_t len;
+    uint8_t  buf[ 8 ];
+
+}T_standin_msg;
+
+static int           standinFd = -1;
+static unsigned long standinCalls;
+static int           standinMsgs;
+static T_standin_msg standinLog[ STANDIN_MSGS_MAX ];
+static uint8_t       standinFrame[ 4 ];
+
+static int failures;
+
+/* Sensor model: write messages are logged, read messages return the current frame */
+static int standinTransfer( struct i2c_rdwr_ioctl_data *xfer )
+{
+    uint32_t i;
+
+    standinCalls++;
+    standinMsgs = 0;
+
+    for ( i = 0; i < xfer->nmsgs; i++ )
+    {
+        if ( standinMsgs < STANDIN_MSGS_MAX )
+        {
+            standinLog[ standinMsgs ].addr = xfer->msgs[ i ].addr;
+            standinLog[ standinMsgs ].flags = xfer->msgs[ i ].flags;
+            standinLog[ standinMsgs ].len = xfer->msgs[ i ].len;
+            if ( !( xfer->msgs[ i ].flags & I2C_M_RD ) )
+                memcpy( standinLog[ standinMsgs ].buf, xfer->msgs[ i ].buf,
+                        ( xfer->msgs[ i ].len < 8 ) ? xfer->msgs[ i ].len : 8 );
+            standinMsgs++;
+        }
+
+        // No acknowledge from other addresses, as the adapter reports it
+        if ( xfer->msgs[ i ].addr != STANDIN_ADDRESS )
+        {
+            errno = ENXIO;
+            return -1;
+        }
+        if ( xfer->msgs[ i ].flags & I2C_M_RD )
+            memcpy( xfer->msgs[ i ].buf, standinFrame, ( xfer->msgs[ i ].len < 4 ) ? xfer->msgs[ i ].len : 4 );
+    }
+
+    return xfer->nmsgs;
+}
+
+int ioctl( int fd, unsigned long request, ... )
+{
+    va_list ap;
+    void *arg;
+
+    va_start( ap, request );
+    arg = va_arg( ap, void* );
+    va_end( ap );
+
+    if ( ( fd == standinFd ) && ( request == I2C_RDWR ) )
+        return standinTransfer( ( struct i2c_rdwr_ioctl_data* )arg );
+
+    return syscall( SYS_ioctl, fd, request, arg );
+}
+
+static void check( int ok, const char *what )
+{
+    if ( ok )
+        return;
+
+    printf( "FAIL  %s\n", what );
+    failures++;
+}
+
+static void setFrame( uint8_t status, uint16_t pressure, uint16_t temperature )
+{
+    standinFrame[ 0 ] = ( status << 6 ) | ( pressure >> 8 );
+    standinFrame[ 1 ] = pressure & 0xFF;
+    standinFrame[ 2 ] = temperature >> 3;
+    standinFrame[ 3 ] = ( temperature << 5 ) & 0xFF;
+}
+
+/* One ioctl with the output address write followed by a read of nBytes */
+static int isCombinedRead( unsigned long calls, uint8_t reg, uint16_t nBytes )
+{
+    return ( standinCalls == calls + 1 ) && ( standinMsgs == 2 ) &&
+           ( standinLog[ 0 ].addr == STANDIN_ADDRESS ) && ( standinLog[ 0 ].flags == 0 ) &&
+           ( standinLog[ 0 ].len == 1 ) && ( standinLog[ 0 ].buf[ 0 ] == reg ) &&
+           ( standinLog[ 1 ].addr == STANDIN_ADDRESS ) && ( standinLog[ 1 ].flags == I2C_M_RD ) &&
+           ( standinLog[ 1 ].len == nBytes );
+}
+
+int main( int argc, char **argv )
+{
+    T_hal_linuxBus i2cBus;
+    T_MANOMETER_SAMPLE sample;
+    struct timespec t0, t1;
+    const uint8_t written[ 5 ] = { 0x12, 0x44, 0x33, 0x22, 0x11 };
+    unsigned long calls, ioctlStart;
+    long nSamples = 1000000;
+    long cnt;
+    uint32_t pressure;
+    int decodeOk = 1;
+    double elapsed;
+
+    if ( argc > 1 )
+        nSamples = atol( argv[ 1 ] );
+
+    standinFd = open( "/dev/null", O_RDWR );
+    if ( standinFd < 0 )
+    {
+        perror( "/dev/null" );
+        return 1;
+    }
+    i2cBus.fd = standinFd;
+    i2cBus.nIoctl = 0;
+    manometer_i2cDriverInit( ( T_MANOMETER_P )0, ( T_MANOMETER_P )&i2cBus, STANDIN_ADDRESS );
+
+    // Sample read: one combined transaction, decoded over every pressure count
+    for ( pressure = 0; pressure < 16384; pressure++ )
+    {
+        setFrame( pressure & 3, pressure, ( pressure * 7 ) & 0x7FF );
+        calls = standinCalls;
+        if ( ( manometer_readSample( &sample ) != _MANOMETER_OK ) || !isCombinedRead( calls, 0x38, 4 ) ||
+             ( sample.status != ( pressure & 3 ) ) || ( sample.pressure != pressure ) ||
+             ( sample.temperature != ( ( pressure * 7 ) & 0x7FF ) ) )
+            decodeOk = 0;
+    }
+    check( decodeOk, "readSample: one I2C_RDWR of write 0x38 + read 4, decoded counts" );
+
+    setFrame( 0, 8192, 1000 );
+    calls = standinCalls;
+    check( ( manometer_getPressurePa() == manometer_countToPascal( 8192 ) ) && isCombinedRead( calls, 0x38, 2 ),
+           "getPressurePa: one I2C_RDWR of write 0x38 + read 2" );
+
+    calls = standinCalls;
+    check( ( manometer_readData( 0x07 ) == ( ( ( uint32_t )standinFrame[ 0 ] << 24 ) | ( ( uint32_t )standinFrame[ 1 ] << 16 ) |
+                                             ( ( uint32_t )standinFrame[ 2 ] << 8 ) | standinFrame[ 3 ] ) ) &&
+           isCombinedRead( calls, 0x07, 4 ), "readData: one I2C_RDWR of write register + read 4" );
+
+    calls = standinCalls;
+    manometer_writeData( 0x12, 0x11223344 );
+    check( ( standinCalls == calls + 1 ) && ( standinMsgs == 1 ) && ( standinLog[ 0 ].flags == 0 ) &&
+           ( standinLog[ 0 ].len == 5 ) && ( memcmp( standinLog[ 0 ].buf, written, 5 ) == 0 ),
+           "writeData: one I2C_RDWR of a single 5-byte write" );
+
+    check( i2cBus.nIoctl == standinCalls, "bus object ioctl count" );
+
+    // Missing sensor: the adapter error reaches the caller
+    manometer_i2cDriverInit( ( T_MANOMETER_P )0, ( T_MANOMETER_P )&i2cBus, STANDIN_ADDRESS + 1 );
+    calls = standinCalls;
+    check( ( manometer_readSample( &sample ) == _MANOMETER_ERR_BUS ) && ( standinCalls == calls + 1 ),
+           "readSample without acknowledge: bus error after one I2C_RDWR" );
+
+    // Driver and HAL cost of a sample read, the model answers at once
+    manometer_i2cDriverInit( ( T_MANOMETER_P )0, ( T_MANOMETER_P )&i2cBus, STANDIN_ADDRESS );
+    setFrame( 0, 8192, 1000 );
+    ioctlStart = i2cBus.nIoctl;
+    clock_gettime( CLOCK_MONOTONIC, &t0 );
+    for ( cnt = 0; cnt < nSamples; cnt++ )
+        manometer_readSample( &sample );
+    clock_gettime( CLOCK_MONOTONIC, &t1 );
+    elapsed = ( t1.tv_sec - t0.tv_sec ) * 1e9 + ( t1.tv_nsec - t0.tv_nsec );
+
+    check( i2cBus.nIoctl - ioctlStart == ( unsigned long )nSamples, "one ioctl per timed sample" );
+
+    printf( " Samples:     %ld\n", nSamples );
+    printf( " Syscalls:    %.2f ioctl/sample\n", ( double )( i2cBus.nIoctl - ioctlStart ) / nSamples );
+    printf( " Overhead:    %.1f ns/sample ( driver and HAL, no bus time )\n", elapsed / nSamples );
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+
+    close( standinFd );
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,205 @@
+/*
+Pressure filter benchmark for Manometer Click
+
+    gcc -O2 -I../../../library Click_Manometer_kalmanbench.c ../../../library/__manometer_driver.c -o Click_Manometer_kalmanbench -lm
+
+---
+
+Description :
+
+Feeds a simulated sensor ( hold, ramp, hold, step, with gaussian count
+noise and jittered sample times ) to the driver two-state pressure
+filter ( manometer_kalmanUpdate() ) and to a moving average. Reports
+residual noise while pressure holds, level error against the true
+pressure, lag on the ramp, rate error and update time per sample.
+
+A gap check then feeds the filter a sample 100 s after a rising ramp
+and one with an earlier time; both must restart the filter at the
+measured pressure. Exit status is 1 when the check fails.
+
+With -c the traces are written as CSV instead, for plotting:
+
+    Click_Manometer_kalmanbench -c > trace.csv
+    gnuplot -e "set datafile separator ','; plot 'trace.csv' u 1:3 w d t 'raw', \
+                '' u 1:2 w l t 'true', '' u 1:4 w l t 'kalman', '' u 1:5 w l t 'average'"
+
+Usage :
+
+    Click_Manometer_kalmanbench [-c] [-n noise] [-q accel] [-w window]
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "__manometer_driver.h"
+
+#define BENCH_PERIOD        10
+#define BENCH_SAMPLES       1000
+#define BENCH_WINDOW_MAX    256
+#define BENCH_RUNS          10000
+
+static double nowSec()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double gaussian()
+{
+    double u1 = ( rand() + 1.0 ) / ( RAND_MAX + 2.0 );
+    double u2 = ( rand() + 1.0 ) / ( RAND_MAX + 2.0 );
+
+    return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+/* True pressure [ counts ] and rate [ counts / s ] at time t [ ms ] */
+static double truePressure( uint32_t t, double *rate )
+{
+    *rate = 0.0;
+    if ( t < 2000 )
+        return 5000.0;
+    if ( t < 5000 )
+    {
+        *rate = 1000.0;
+        return 5000.0 + ( t - 2000 );
+    }
+    if ( t < 7000 )
+        return 8000.0;
+
+    return 7500.0;
+}
+
+int main( int argc, char **argv )
+{
+    T_MANOMETER_KALMAN kalman;
+    T_MANOMETER_KALMAN gapFilter;
+    uint16_t raw[ BENCH_SAMPLES ];
+    uint32_t times[ BENCH_SAMPLES ];
+    uint16_t window[ BENCH_WINDOW_MAX ];
+    double noise = 4.0;
+    double accel = 2000.0;
+    int windowSize = 16;
+    int csv = 0;
+    double truth, trueRate, average;
+    double errK = 0, errA = 0, errRate = 0, lagK = 0, lagA = 0;
+    double rateErr;
+    double noiseK = 0, noiseA = 0;
+    int nHold = 0, nRamp = 0, nRate = 0;
+    uint16_t level;
+    double t0, elapsed;
+    int opt;
+    int filled;
+    int gapOk;
+    int i, k, run;
+
+    while ( ( opt = getopt( argc, argv, "cn:q:w:" ) ) != -1 )
+    {
+        if ( opt == 'c' )
+            csv = 1;
+        else if ( opt == 'n' )
+            noise = atof( optarg );
+        else if ( opt == 'q' )
+            accel = atof( optarg );
+        else if ( opt == 'w' )
+            windowSize = atoi( optarg );
+    }
+    if ( ( windowSize < 1 ) || ( windowSize > BENCH_WINDOW_MAX ) )
+        windowSize = 16;
+
+    srand( 1 );
+    times[ 0 ] = 0;
+    for ( i = 0; i < BENCH_SAMPLES; i++ )
+    {
+        if ( i > 0 )
+            times[ i ] = times[ i - 1 ] + BENCH_PERIOD - 1 + rand() % 3;
+        raw[ i ] = ( uint16_t )( truePressure( times[ i ], &trueRate ) + noise * gaussian() + 0.5 );
+    }
+
+    manometer_kalmanInit( &kalman, 0, 0 );
+    manometer_kalmanTune( &kalman, accel, noise, BENCH_PERIOD );
+
+    if ( csv )
+        printf( "time,true,raw,kalman,average,trueRate,kalmanRate\n" );
+
+    for ( i = 0; i < BENCH_SAMPLES; i++ )
+    {
+        truth = truePressure( times[ i ], &trueRate );
+        level = manometer_kalmanUpdate( &kalman, raw[ i ], times[ i ] );
+
+        window[ i % windowSize ] = raw[ i ];
+        filled = ( i < windowSize ) ? i + 1 : windowSize;
+        average = 0;
+        for ( k = 0; k < filled; k++ )
+            average += window[ k ];
+        average /= filled;
+
+        if ( csv )
+        {
+            printf( "%u,%.1f,%u,%u,%.1f,%.1f,%d\n", times[ i ], truth, raw[ i ], level, average,
+                    trueRate, manometer_kalmanGetRate( &kalman ) );
+            continue;
+        }
+        if ( times[ i ] < 1000 )
+            continue;
+        if ( times[ i ] < 2000 )
+        {
+            noiseK += ( level - truth ) * ( level - truth );
+            noiseA += ( average - truth ) * ( average - truth );
+            nHold++;
+        }
+        errK += ( level - truth ) * ( level - truth );
+        errA += ( average - truth ) * ( average - truth );
+        if ( ( times[ i ] >= 3000 ) && ( times[ i ] < 5000 ) )
+        {
+            lagK += truth - level;
+            lagA += truth - average;
+            rateErr = manometer_kalmanGetRate( &kalman ) - trueRate;
+            errRate += rateErr * rateErr;
+            nRamp++;
+        }
+        nRate++;
+    }
+    if ( csv )
+        return 0;
+
+    // Long gap and time going backwards: no prediction across them
+    manometer_kalmanInit( &gapFilter, kalman.alpha, kalman.beta );
+    for ( i = 0; i < 100; i++ )
+        manometer_kalmanUpdate( &gapFilter, 5000 + i * 10, i * BENCH_PERIOD );
+    gapOk = ( manometer_kalmanGetRate( &gapFilter ) > 500 );
+    gapOk &= ( manometer_kalmanUpdate( &gapFilter, 6000, 100000 + 99 * BENCH_PERIOD ) == 6000 );
+    gapOk &= ( manometer_kalmanGetRate( &gapFilter ) == 0 );
+    manometer_kalmanUpdate( &gapFilter, 6000, 100000 + 100 * BENCH_PERIOD );
+    gapOk &= ( manometer_kalmanUpdate( &gapFilter, 4000, 100000 ) == 4000 );
+
+    t0 = nowSec();
+    for ( run = 0; run < BENCH_RUNS; run++ )
+    {
+        kalman.primed = 0;
+        for ( i = 0; i < BENCH_SAMPLES; i++ )
+            manometer_kalmanUpdate( &kalman, raw[ i ], times[ i ] );
+    }
+    elapsed = nowSec() - t0;
+
+    printf( "gains           alpha %.4f beta %.4f\n", kalman.alpha / 32768.0, kalman.beta / 32768.0 );
+    printf( "hold noise rms  kalman %.2f counts, average(%d) %.2f counts, raw %.2f counts\n",
+            sqrt( noiseK / nHold ), windowSize, sqrt( noiseA / nHold ), noise );
+    printf( "level rms error kalman %.2f counts, average(%d) %.2f counts\n",
+            sqrt( errK / nRate ), windowSize, sqrt( errA / nRate ) );
+    printf( "ramp lag        kalman %.2f counts, average(%d) %.2f counts\n",
+            lagK / nRamp, windowSize, lagA / nRamp );
+    printf( "ramp rate error kalman %.1f counts/s rms\n", sqrt( errRate / nRamp ) );
+    printf( "update time     %.2f ns/sample\n", elapsed * 1e9 / ( ( double ) BENCH_RUNS * BENCH_SAMPLES ) );
+    printf( "gap check       %s\n", gapOk ? "PASS" : "FAIL" );
+
+    return gapOk ? 0 : 1;
+}
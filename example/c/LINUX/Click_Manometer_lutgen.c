@@ -0,0 +1,105 @@
+/*
+Conversion table generator for Manometer Click
+
+    gcc -O2 Click_Manometer_lutgen.c -o Click_Manometer_lutgen
+
+---
+
+Description :
+
+Writes library/__manometer_lut.h, the piecewise tables used by the
+driver when __MANOMETER_LUT__ is defined. Pressure is tabulated in Pa
+every 64 counts of the 14-bit range, temperature in 0.01 degC every
+32 counts of the 11-bit range; the driver interpolates linearly between
+entries. Part range and calibration are fixed when the table is built.
+
+Usage :
+
+    Click_Manometer_lutgen [-p pmin pmax] [-o countmin countmax] [-c offset gain] > __manometer_lut.h
+
+    -p    pressure range of the part in Pa            ( default 0 417700 )
+    -o    output range in counts                      ( default 1638 14745 )
+    -c    calibration, offset in Pa and gain          ( default 0 1 )
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define LUT_PRESSURE_SHIFT      6
+#define LUT_TEMPERATURE_SHIFT   5
+
+static long roundHalfAway( double value )
+{
+    return ( value < 0 ) ? ( long )( value - 0.5 ) : ( long )( value + 0.5 );
+}
+
+static void writeTable( const char *name, long *table, int n )
+{
+    int i;
+
+    printf( "static const int32_t %s[ %d ] =\n{\n", name, n );
+    for ( i = 0; i < n; i++ )
+        printf( "%s%7ld%s", ( i % 8 ) ? " " : "    ", table[ i ], ( i == n - 1 ) ? "\n" : ( ( i % 8 ) == 7 ) ? ",\n" : "," );
+    printf( "};\n\n" );
+}
+
+int main( int argc, char **argv )
+{
+    double pMin = 0.0, pMax = 417700.0;
+    double countMin = 1638.0, countMax = 14745.0;
+    double offset = 0.0, gain = 1.0;
+    long pressure[ ( 16384 >> LUT_PRESSURE_SHIFT ) + 1 ];
+    long temperature[ ( 2048 >> LUT_TEMPERATURE_SHIFT ) + 1 ];
+    int nPressure = sizeof( pressure ) / sizeof( pressure[ 0 ] );
+    int nTemperature = sizeof( temperature ) / sizeof( temperature[ 0 ] );
+    int opt;
+    int i;
+
+    while ( ( opt = getopt( argc, argv, "p:o:c:" ) ) != -1 )
+    {
+        if ( ( optind >= argc ) || ( ( opt != 'p' ) && ( opt != 'o' ) && ( opt != 'c' ) ) )
+        {
+            fprintf( stderr, "usage: %s [-p pmin pmax] [-o countmin countmax] [-c offset gain]\n", argv[ 0 ] );
+            return 1;
+        }
+        if ( opt == 'p' )
+        {
+            pMin = atof( optarg );
+            pMax = atof( argv[ optind++ ] );
+        }
+        else if ( opt == 'o' )
+        {
+            countMin = atof( optarg );
+            countMax = atof( argv[ optind++ ] );
+        }
+        else
+        {
+            offset = atof( optarg );
+            gain = atof( argv[ optind++ ] );
+        }
+    }
+
+    for ( i = 0; i < nPressure; i++ )
+        pressure[ i ] = roundHalfAway( offset + gain * ( ( i << LUT_PRESSURE_SHIFT ) - countMin ) *
+                                       ( pMax - pMin ) / ( countMax - countMin ) + gain * pMin );
+    for ( i = 0; i < nTemperature; i++ )
+        temperature[ i ] = roundHalfAway( ( ( i << LUT_TEMPERATURE_SHIFT ) * 200.0 / 2047.0 - 50.0 ) * 100.0 );
+
+    printf( "/*\n    __manometer_lut.h\n\n" );
+    printf( "    Generated by Click_Manometer_lutgen -p %g %g -o %g %g -c %g %g\n", pMin, pMax, countMin, countMax, offset, gain );
+    printf( "    Do not edit, regenerate for another part or calibration.\n*/\n\n" );
+    printf( "#ifndef _MANOMETER_LUT_H_\n#define _MANOMETER_LUT_H_\n\n" );
+    printf( "#define _LUT_PRESSURE_SHIFT       %d\n", LUT_PRESSURE_SHIFT );
+    printf( "#define _LUT_TEMPERATURE_SHIFT    %d\n\n", LUT_TEMPERATURE_SHIFT );
+    printf( "// Pressure [ Pa ] at count i * 2^_LUT_PRESSURE_SHIFT\n" );
+    writeTable( "_lutPressure", pressure, nPressure );
+    printf( "// Temperature [ 0.01 degC ] at count i * 2^_LUT_TEMPERATURE_SHIFT\n" );
+    writeTable( "_lutTemperature", temperature, nTemperature );
+    printf( "#endif\n" );
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+/*
+Range query tool for the Manometer Click sample archive
+
+    gcc -O2 -I../../../library Click_Manometer_query.c -o Click_Manometer_query
+
+---
+
+Description :
+
+Prints every sample of one sensor archive ( Click_Manometer_archive.h )
+with from <= time < to, or with "-s" only count, min, max and mean of
+the pressure counts. Segments outside the range are skipped by header,
+the start position is found through the sparse time index.
+
+from and to are UTC date and time, YYYY-MM-DDTHH:MM:SS[.fraction][Z],
+or nanoseconds since the Unix epoch. Times are printed in nanoseconds,
+or with "-u" as UTC date and time.
+
+Usage :
+
+    Click_Manometer_query [-s] [-u] <archive-dir> <from> <to>
+
+    Click_Manometer_query -u archive/0x28 2026-10-19T08:00:00 2026-10-19T08:05:00
+
+*/
+
+#define _DEFAULT_SOURCE
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#include "Click_Manometer_archive.h"
+
+static int isSegment( const struct dirent *ent )
+{
+    size_t len = strlen( ent->d_name );
+
+    return ( len > 4 ) && ( strcmp( ent->d_name + len - 4, ".mca" ) == 0 );
+}
+
+/* UTC date and time or plain nanoseconds since the epoch; returns -1 when not valid */
+static int parseTime( const char *text, uint64_t *ns )
+{
+    struct tm tm;
+    const char *rest;
+    char *end;
+    uint64_t frac = 0;
+    uint64_t scale = 100000000ULL;
+    time_t sec;
+
+    *ns = strtoull( text, &end, 0 );
+    if ( ( end != text ) && ( *end == 0 ) )
+        return 0;
+
+    memset( &tm, 0, sizeof( tm ) );
+    rest = strptime( text, "%Y-%m-%dT%H:%M:%S", &tm );
+    if ( rest == NULL )
+        return -1;
+    if ( *rest == '.' )
+    {
+        for ( rest++; ( *rest >= '0' ) && ( *rest <= '9' ); rest++ )
+        {
+            frac += ( *rest - '0' ) * scale;
+            scale /= 10;
+        }
+    }
+    if ( *rest == 'Z' )
+        rest++;
+    if ( *rest != 0 )
+        return -1;
+
+    sec = timegm( &tm );
+    *ns = ( uint64_t )sec * 1000000000ULL + frac;
+
+    return 0;
+}
+
+static void printTime( uint64_t ns, int utc )
+{
+    struct tm tm;
+    time_t sec = ( time_t )( ns / 1000000000ULL );
+    char text[ 32 ];
+
+    if ( !utc )
+    {
+        printf( "%llu", ( unsigned long long )ns );
+        return;
+    }
+    gmtime_r( &sec, &tm );
+    strftime( text, sizeof( text ), "%Y-%m-%dT%H:%M:%S", &tm );
+    printf( "%s.%09lluZ", text, ( unsigned long long )( ns % 1000000000ULL ) );
+}
+
+int main( int argc, char **argv )
+{
+    T_archive_segment seg;
+    struct dirent **list;
+    char path[ ARCHIVE_PATH_MAX + 256 ];
+    uint64_t from, to;
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint16_t minP = 0xFFFF;
+    uint16_t maxP = 0;
+    uint32_t pos;
+    int statsOnly = 0;
+    int utc = 0;
+    int arg;
+    int opt;
+    int n, i;
+
+    while ( ( opt = getopt( argc, argv, "su" ) ) != -1 )
+    {
+        if ( opt == 's' )
+            statsOnly = 1;
+        else if ( opt == 'u' )
+            utc = 1;
+        else
+            optind = argc;
+    }
+    arg = optind;
+    if ( argc - arg < 3 )
+    {
+        fprintf( stderr, "usage: %s [-s] [-u] <archive-dir> <from> <to>\n", argv[ 0 ] );
+        return 1;
+    }
+    if ( ( parseTime( argv[ arg + 1 ], &from ) != 0 ) || ( parseTime( argv[ arg + 2 ], &to ) != 0 ) )
+    {
+        fprintf( stderr, "%s: time is YYYY-MM-DDTHH:MM:SS[.fraction][Z] UTC or ns since epoch\n", argv[ 0 ] );
+        return 1;
+    }
+
+    n = scandir( argv[ arg ], &list, isSegment, alphasort );
+    if ( n < 0 )
+    {
+        perror( argv[ arg ] );
+        return 1;
+    }
+
+    for ( i = 0; i < n; i++ )
+    {
+        snprintf( path, sizeof( path ), "%s/%s", argv[ arg ], list[ i ]->d_name );
+        free( list[ i ] );
+        if ( archive_segmentOpen( &seg, path ) != 0 )
+            continue;
+
+        if ( ( seg.hdr->count > 0 ) && ( seg.hdr->lastTime >= from ) && ( seg.hdr->firstTime < to ) )
+        {
+            for ( pos = archive_segmentFind( &seg, from ); pos < seg.hdr->count; pos++ )
+            {
+                if ( seg.time[ pos ] >= to )
+                    break;
+                if ( statsOnly )
+                {
+                    count++;
+                    sum += seg.pressure[ pos ];
+                    if ( seg.pressure[ pos ] < minP )
+                        minP = seg.pressure[ pos ];
+                    if ( seg.pressure[ pos ] > maxP )
+                        maxP = seg.pressure[ pos ];
+                }
+                else
+                {
+                    printTime( seg.time[ pos ], utc );
+                    printf( " %u %u %u\n", seg.status[ pos ], seg.pressure[ pos ], seg.temperature[ pos ] );
+                }
+            }
+        }
+        archive_segmentClose( &seg );
+    }
+    free( list );
+
+    if ( statsOnly )
+        printf( "count %llu min %u max %u mean %.2f\n", ( unsigned long long )count,
+                count ? minP : 0, maxP, count ? ( double )sum / count : 0.0 );
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+/*
+Shared bus queue simulation for Manometer Click
+
+    gcc -O2 -D__HAL_SIM__ -I../../../library Click_Manometer_queuesim.c ../../../library/__manometer_driver.c -o Click_Manometer_queuesim
+
+---
+
+Description :
+
+Runs three producers on one simulated I2C bus ( __HAL_SIM__, virtual
+time ) for a fixed span and reports how long the time-critical
+pressure read waits:
+
+- pressure    Manometer Click at 0x28, 4-byte read every 1 ms, priority 3
+- logger      EEPROM at 0x50, 2 + 64-byte page write every 10 ms, priority 2
+- display     OLED at 0x3C, 1024-byte frame every 50 ms, priority 1
+
+With -m lock every producer issues each transfer whole and in arrival
+order, as plain bus locking does. With -m queue ( default ) transfers
+go through manometer_queueSubmit() with their priorities and long ones
+are split into parts of -p bytes, so the pressure read is served
+between parts. -b sets the transfers served per bus lock.
+
+Usage :
+
+    Click_Manometer_queuesim [-m lock|queue] [-b batch] [-p part] [-s speed] [-t ms]
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "__HAL_SIM.h"
+#include "__manometer_driver.h"
+
+#define SIM_PRODUCERS       2
+#define SIM_PARTS_MAX       64
+#define SIM_SLOTS           ( SIM_PRODUCERS * SIM_PARTS_MAX + 1 )
+#define SIM_LATENCY_BINS    100000
+
+typedef struct
+{
+    const char         *name;
+    uint8_t            address;
+    uint16_t           header;
+    uint16_t           payload;
+    unsigned long long period;
+    uint8_t            priority;
+    unsigned long long due;
+    T_MANOMETER_XFER   parts[ SIM_PARTS_MAX ];
+    uint8_t            buffer[ SIM_PARTS_MAX ][ 1100 ];
+    uint16_t           nParts;
+    unsigned long      sent;
+    unsigned long      skipped;
+
+}T_producer;
+
+static T_hal_simBus bus;
+static T_MANOMETER_QUEUE queue;
+static T_MANOMETER_XFER *slots[ SIM_SLOTS ];
+static unsigned long nLocks;
+static unsigned long latencyHist[ SIM_LATENCY_BINS ];
+
+static T_producer producers[ SIM_PRODUCERS ] =
+{
+    { .name = "logger",  .address = 0x50, .header = 2, .payload =   64, .period = 10000000ULL, .priority = 2 },
+    { .name = "display", .address = 0x3C, .header = 1, .payload = 1024, .period = 50000000ULL, .priority = 1 },
+};
+
+/* Manometer answers with a slowly moving pressure, other devices acknowledge writes */
+static int device( void *context, uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t isRead )
+{
+    uint16_t pressure = 8000 + ( uint16_t )( ( bus.time / 1000000ULL ) % 1000 );
+    uint8_t frame[ 4 ];
+
+    (void)context;
+    if ( !isRead )
+        return 0;
+    if ( slaveAddress != 0x28 )
+        return -1;
+
+    frame[ 0 ] = pressure >> 8;
+    frame[ 1 ] = pressure & 0xFF;
+    frame[ 2 ] = 0x7D;
+    frame[ 3 ] = 0x00;
+    memcpy( pBuf, frame, ( nBytes < 4 ) ? nBytes : 4 );
+
+    return 0;
+}
+
+static uint8_t countLock( uint8_t priority )
+{
+    (void)priority;
+    nLocks++;
+
+    return 0;
+}
+
+static void noUnlock( void )
+{
+}
+
+static int producerBusy( T_producer *p )
+{
+    uint16_t i;
+
+    for ( i = 0; i < p->nParts; i++ )
+        if ( p->parts[ i ].status == _MANOMETER_XFER_PENDING )
+            return 1;
+
+    return 0;
+}
+
+/* Submits one transfer of the producer, whole or split into parts with the header repeated */
+static void producerSubmit( T_producer *p, int split, uint16_t part )
+{
+    uint16_t left = p->payload;
+    uint16_t len;
+    T_MANOMETER_XFER *xfer;
+
+    if ( producerBusy( p ) )
+    {
+        p->skipped++;
+        return;
+    }
+
+    p->nParts = 0;
+    while ( left > 0 )
+    {
+        len = ( split && ( left > part ) ) ? part : left;
+        xfer = &p->parts[ p->nParts ];
+        memset( p->buffer[ p->nParts ], 0x55, p->header + len );
+        xfer->slaveAddress = p->address;
+        xfer->writeBuf = p->buffer[ p->nParts ];
+        xfer->nWrite = p->header + len;
+        xfer->readBuf = 0;
+        xfer->nRead = 0;
+        xfer->priority = split ? p->priority : 0;
+        xfer->busSpeed = bus.speed;
+        manometer_queueSubmit( &queue, xfer );
+        p->nParts++;
+        left -= len;
+    }
+    p->sent++;
+}
+
+int main( int argc, char **argv )
+{
+    T_MANOMETER_SAMPLE sample;
+    unsigned long long span = 10000ULL * 1000000ULL;
+    unsigned long long pressureDue = 0;
+    unsigned long long next;
+    unsigned long long latency, latencyMax = 0;
+    double latencySum = 0;
+    unsigned long nReads = 0, late = 0, errors = 0;
+    unsigned long p99Count, acc;
+    unsigned long p99;
+    unsigned long busyBits;
+    uint32_t speed = 400000;
+    uint16_t part = 32;
+    uint8_t batch = 1;
+    int split = 1;
+    int opt;
+    int i;
+
+    while ( ( opt = getopt( argc, argv, "m:b:p:s:t:" ) ) != -1 )
+    {
+        if ( opt == 'm' )
+            split = ( strcmp( optarg, "lock" ) != 0 );
+        else if ( opt == 'b' )
+            batch = atoi( optarg );
+        else if ( opt == 'p' )
+            part = atoi( optarg );
+        else if ( opt == 's' )
+            speed = atol( optarg );
+        else if ( opt == 't' )
+            span = atoll( optarg ) * 1000000ULL;
+        else
+        {
+            fprintf( stderr, "usage: %s [-m lock|queue] [-b batch] [-p part] [-s speed] [-t ms]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+    // Display frame must fit in SIM_PARTS_MAX parts
+    if ( part < 1024 / SIM_PARTS_MAX )
+        part = 1024 / SIM_PARTS_MAX;
+
+    bus.device = device;
+    bus.speed = speed;
+    manometer_i2cDriverInit( ( T_MANOMETER_P )0, ( T_MANOMETER_P )&bus, 0x28 );
+    manometer_setBusArbiter( countLock, noUnlock, split ? 3 : 0 );
+    manometer_queueInit( &queue, slots, SIM_SLOTS, batch );
+    manometer_setBusQueue( &queue );
+
+    while ( bus.time < span )
+    {
+        for ( i = 0; i < SIM_PRODUCERS; i++ )
+        {
+            if ( producers[ i ].due <= bus.time )
+            {
+                producerSubmit( &producers[ i ], split, part );
+                producers[ i ].due += producers[ i ].period;
+            }
+        }
+
+        if ( pressureDue <= bus.time )
+        {
+            if ( manometer_readSample( &sample ) != _MANOMETER_OK )
+                errors++;
+            latency = bus.time - pressureDue;
+            latencySum += latency;
+            if ( latency > latencyMax )
+                latencyMax = latency;
+            if ( latency >= 1000000ULL )
+                late++;
+            latencyHist[ ( latency / 1000 < SIM_LATENCY_BINS ) ? latency / 1000 : SIM_LATENCY_BINS - 1 ]++;
+            nReads++;
+            pressureDue += 1000000ULL;
+            continue;
+        }
+
+        if ( manometer_queueGetCount( &queue ) != 0 )
+        {
+            manometer_queueService( &queue );
+            continue;
+        }
+
+        // Bus idle until the next producer is due
+        next = pressureDue;
+        for ( i = 0; i < SIM_PRODUCERS; i++ )
+            if ( producers[ i ].due < next )
+                next = producers[ i ].due;
+        bus.time = next;
+    }
+
+    p99Count = nReads - nReads / 100;
+    for ( p99 = 0, acc = latencyHist[ 0 ]; ( p99 < SIM_LATENCY_BINS - 1 ) && ( acc < p99Count ); )
+        acc += latencyHist[ ++p99 ];
+    // Data bytes, plus address byte, start and stop per transaction
+    busyBits = bus.nBytes * 9 + bus.nStart * 11;
+
+    printf( "mode            %s, %u kHz, %s, batch %u\n", split ? "queue" : "lock", speed / 1000,
+            split ? "split" : "whole transfers", batch );
+    printf( "pressure reads  %lu ( %lu errors ), latency %.1f us mean, %lu us p99, %.1f us worst\n",
+            nReads, errors, latencySum / nReads / 1000.0, p99, latencyMax / 1000.0 );
+    printf( "late reads      %lu ( latency >= 1 ms period )\n", late );
+    for ( i = 0; i < SIM_PRODUCERS; i++ )
+        printf( "%-15s %lu transfers, %lu skipped while previous pending\n", producers[ i ].name,
+                producers[ i ].sent, producers[ i ].skipped );
+    printf( "bus             %.1f %% busy, %lu locks for %lu starts\n",
+            busyBits * 1e9 / speed / span * 100.0, nLocks, bus.nStart );
+
+    return 0;
+}
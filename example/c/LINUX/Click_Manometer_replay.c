@@ -0,0 +1,128 @@
+/*
+Recorded frame replay for Manometer Click
+
+    gcc -O2 -D__HAL_REPLAY__ -I../../../library Click_Manometer_replay.c ../../../library/__manometer_driver.c -o Click_Manometer_replay
+
+---
+
+Description :
+
+Runs a recording of raw sensor frames ( __HAL_REPLAY.c format, as
+written by Click_Manometer_LINUX -r ) through the real driver and the
+processing pipeline: sample decode, two-state pressure filter and
+deadband reporter. No real time is involved, so the run is as fast as
+the host allows and the output depends only on the recording and the
+options. Diff the output of two runs to see the effect of a change.
+
+Output has one line per frame:
+
+    <time> <status> <pressure> <temperature> <filtered> <rate> <report>
+
+Replay throughput is written to standard error.
+
+Usage :
+
+    Click_Manometer_replay [-q accel] [-n noise] [-p period] [-d threshold] <recording>
+
+    -q, -n, -p    filter tuning, see manometer_kalmanTune()   ( default 2000 4 10 )
+    -d            deadband threshold in counts                  ( default 8 )
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "__HAL_REPLAY.h"
+#include "__manometer_driver.h"
+
+static T_hal_replayBus replayBus;
+
+static double nowSec()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main( int argc, char **argv )
+{
+    T_MANOMETER_SAMPLE sample;
+    T_MANOMETER_KALMAN kalman;
+    T_MANOMETER_DEADBAND deadband;
+    float accel = 2000.0;
+    float noise = 4.0;
+    uint16_t period = 10;
+    uint16_t threshold = 8;
+    uint16_t filtered;
+    uint8_t report;
+    uint32_t timeMs;
+    unsigned long nFrames = 0;
+    unsigned long nErrors = 0;
+    double t0, elapsed;
+    int opt;
+
+    while ( ( opt = getopt( argc, argv, "q:n:p:d:" ) ) != -1 )
+    {
+        if ( opt == 'q' )
+            accel = atof( optarg );
+        else if ( opt == 'n' )
+            noise = atof( optarg );
+        else if ( opt == 'p' )
+            period = atoi( optarg );
+        else if ( opt == 'd' )
+            threshold = atoi( optarg );
+        else
+            optind = argc;
+    }
+    if ( optind >= argc )
+    {
+        fprintf( stderr, "usage: %s [-q accel] [-n noise] [-p period] [-d threshold] <recording>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    replayBus.file = fopen( argv[ optind ], "r" );
+    if ( replayBus.file == NULL )
+    {
+        perror( argv[ optind ] );
+        return 1;
+    }
+    replayBus.end = 0;
+    manometer_i2cDriverInit( (T_MANOMETER_P)0, (T_MANOMETER_P)&replayBus, _MANOMETER_I2C_ADDRESS );
+
+    manometer_kalmanInit( &kalman, 0, 0 );
+    manometer_kalmanTune( &kalman, accel, noise, period );
+    manometer_deadbandInit( &deadband, threshold, 0 );
+
+    t0 = nowSec();
+    for ( ;; )
+    {
+        if ( manometer_readSample( &sample ) != _MANOMETER_OK )
+        {
+            if ( replayBus.end )
+                break;
+            nErrors++;
+            continue;
+        }
+        nFrames++;
+
+        timeMs = ( uint32_t )( replayBus.time / 1000ULL );
+        filtered = manometer_kalmanUpdate( &kalman, sample.pressure, timeMs );
+        report = manometer_deadbandUpdate( &deadband, filtered, timeMs );
+
+        printf( "%llu %u %u %u %u %d %u\n", replayBus.time, sample.status, sample.pressure,
+                sample.temperature, filtered, manometer_kalmanGetRate( &kalman ), report );
+    }
+    elapsed = nowSec() - t0;
+    fclose( replayBus.file );
+
+    fprintf( stderr, "%lu frames, %lu errors, %.0f samples/s\n", nFrames, nErrors,
+             ( elapsed > 0 ) ? nFrames / elapsed : 0.0 );
+
+    return 0;
+}
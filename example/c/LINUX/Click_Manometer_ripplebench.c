@@ -0,0 +1,221 @@
+/*
+Ripple analysis benchmark for Manometer Click
+
+    gcc -O2 -I../../../library Click_Manometer_ripplebench.c ../../../library/__manometer_driver.c -o Click_Manometer_ripplebench -lm
+
+---
+
+Description :
+
+Feeds a simulated pump line ( slowly drifting pressure, 50 Hz pump
+ripple with its 100 Hz harmonic, a 120 Hz component and gaussian count
+noise ) to the driver Goertzel bank ( manometer_rippleUpdate() ) and to a
+double precision DFT at the same frequencies over the same blocks.
+Reports per band the true amplitude, the driver amplitude and its
+largest deviation from the reference, then the update time per sample
+of the driver bank and of a plain double precision Goertzel bank for
+comparison, and the state size per band. On a host with a fast FPU the
+double bank is quicker; the Q14 bank is meant for targets without one.
+
+Frequencies that fall between DFT bins ( f * block / rate not an
+integer ) leak into the neighbouring bins in both, which is expected.
+
+Usage :
+
+    Click_Manometer_ripplebench [-r rate] [-n block] [-s noise] [freq ...]
+
+    default bands 50 100 120 150 Hz, rate 1000 Hz, block 1000, noise 2 counts
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "__manometer_driver.h"
+
+#define BENCH_BANDS_MAX     16
+#define BENCH_BLOCKS        20
+#define BENCH_RUNS          50
+#define BENCH_MBAR          ( 4.177 / 13107.0 * 1000.0 )
+
+static const double toneFreq[ 3 ] = { 50.0, 100.0, 120.0 };
+static const double toneAmp[ 3 ] = { 40.0, 12.0, 6.0 };
+
+static double nowSec()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double gaussian()
+{
+    double u1 = ( rand() + 1.0 ) / ( RAND_MAX + 2.0 );
+    double u2 = ( rand() + 1.0 ) / ( RAND_MAX + 2.0 );
+
+    return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+/* True ripple amplitude [ counts ] at frequency f */
+static double trueAmplitude( double f )
+{
+    int i;
+
+    for ( i = 0; i < 3; i++ )
+        if ( fabs( toneFreq[ i ] - f ) < 1e-9 )
+            return toneAmp[ i ];
+
+    return 0.0;
+}
+
+/* Amplitude [ counts ] of one frequency over a block, mean removed */
+static double dftAmplitude( const uint16_t *x, int n, double f, double rate )
+{
+    double mean = 0, re = 0, im = 0;
+    int i;
+
+    for ( i = 0; i < n; i++ )
+        mean += x[ i ];
+    mean /= n;
+    for ( i = 0; i < n; i++ )
+    {
+        re += ( x[ i ] - mean ) * cos( 2.0 * M_PI * f * i / rate );
+        im -= ( x[ i ] - mean ) * sin( 2.0 * M_PI * f * i / rate );
+    }
+
+    return 2.0 * sqrt( re * re + im * im ) / n;
+}
+
+int main( int argc, char **argv )
+{
+    T_MANOMETER_RIPPLE ripple;
+    T_MANOMETER_TONE tones[ BENCH_BANDS_MAX ];
+    double freq[ BENCH_BANDS_MAX ] = { 50.0, 100.0, 120.0, 150.0 };
+    double coeff[ BENCH_BANDS_MAX ], s1[ BENCH_BANDS_MAX ], s2[ BENCH_BANDS_MAX ];
+    double driverAmp[ BENCH_BANDS_MAX ], refAmp[ BENCH_BANDS_MAX ], worst[ BENCH_BANDS_MAX ];
+    double rate = 1000.0;
+    double noise = 2.0;
+    double value, s0, t0, tDriver, tDouble;
+    volatile double sink = 0;
+    uint16_t *samples;
+    int nBands = 4;
+    int block = 1000;
+    int nSamples;
+    int opt;
+    int i, k, b, run;
+
+    while ( ( opt = getopt( argc, argv, "r:n:s:" ) ) != -1 )
+    {
+        if ( opt == 'r' )
+            rate = atof( optarg );
+        else if ( opt == 'n' )
+            block = atoi( optarg );
+        else if ( opt == 's' )
+            noise = atof( optarg );
+        else
+        {
+            fprintf( stderr, "usage: %s [-r rate] [-n block] [-s noise] [freq ...]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+    if ( optind < argc )
+    {
+        for ( nBands = 0; ( optind < argc ) && ( nBands < BENCH_BANDS_MAX ); nBands++ )
+            freq[ nBands ] = atof( argv[ optind++ ] );
+    }
+    if ( ( block < 2 ) || ( block > 65535 ) )
+        block = 1000;
+
+    nSamples = block * BENCH_BLOCKS;
+    samples = malloc( nSamples * sizeof( uint16_t ) );
+    if ( samples == NULL )
+        return 1;
+
+    srand( 1 );
+    for ( i = 0; i < nSamples; i++ )
+    {
+        value = 8000.0 + 200.0 * sin( 2.0 * M_PI * 0.05 * i / rate ) + noise * gaussian();
+        for ( k = 0; k < 3; k++ )
+            value += toneAmp[ k ] * cos( 2.0 * M_PI * toneFreq[ k ] * i / rate + k );
+        samples[ i ] = ( uint16_t )( value + 0.5 );
+    }
+
+    // Accuracy against the reference, block by block
+    manometer_rippleInit( &ripple, tones, nBands, block );
+    for ( b = 0; b < nBands; b++ )
+    {
+        manometer_rippleSetBand( &ripple, b, freq[ b ], rate );
+        worst[ b ] = 0;
+    }
+    for ( i = 0; i < nSamples; i++ )
+    {
+        if ( !manometer_rippleUpdate( &ripple, samples[ i ] ) )
+            continue;
+        for ( b = 0; b < nBands; b++ )
+        {
+            driverAmp[ b ] = manometer_rippleGetAmplitude( &ripple, b );
+            refAmp[ b ] = dftAmplitude( samples + i + 1 - block, block, freq[ b ], rate ) * BENCH_MBAR;
+            if ( fabs( driverAmp[ b ] - refAmp[ b ] ) > worst[ b ] )
+                worst[ b ] = fabs( driverAmp[ b ] - refAmp[ b ] );
+        }
+    }
+
+    printf( "rate %.0f Hz, block %d, %d blocks, noise %.1f counts\n", rate, block, BENCH_BLOCKS, noise );
+    printf( "band [ Hz ]   true [ mbar ]   driver [ mbar ]   reference [ mbar ]   worst deviation [ mbar ]\n" );
+    for ( b = 0; b < nBands; b++ )
+        printf( "%9.2f   %13.3f   %15.3f   %18.3f   %24.4f\n", freq[ b ], trueAmplitude( freq[ b ] ) * BENCH_MBAR,
+                driverAmp[ b ], refAmp[ b ], worst[ b ] );
+
+    // Update cost: driver fixed-point bank against a double precision Goertzel bank
+    t0 = nowSec();
+    for ( run = 0; run < BENCH_RUNS; run++ )
+        for ( i = 0; i < nSamples; i++ )
+            manometer_rippleUpdate( &ripple, samples[ i ] );
+    tDriver = ( nowSec() - t0 ) / ( ( double )BENCH_RUNS * nSamples );
+
+    for ( b = 0; b < nBands; b++ )
+    {
+        coeff[ b ] = 2.0 * cos( 2.0 * M_PI * freq[ b ] / rate );
+        s1[ b ] = 0;
+        s2[ b ] = 0;
+    }
+    t0 = nowSec();
+    for ( run = 0; run < BENCH_RUNS; run++ )
+    {
+        for ( i = 0; i < nSamples; i++ )
+        {
+            for ( b = 0; b < nBands; b++ )
+            {
+                s0 = samples[ i ] + coeff[ b ] * s1[ b ] - s2[ b ];
+                s2[ b ] = s1[ b ];
+                s1[ b ] = s0;
+            }
+            if ( ( i + 1 ) % block == 0 )
+            {
+                for ( b = 0; b < nBands; b++ )
+                {
+                    sink += sqrt( s1[ b ] * s1[ b ] + s2[ b ] * s2[ b ] - coeff[ b ] * s1[ b ] * s2[ b ] );
+                    s1[ b ] = 0;
+                    s2[ b ] = 0;
+                }
+            }
+        }
+    }
+    tDouble = ( nowSec() - t0 ) / ( ( double )BENCH_RUNS * nSamples );
+
+    printf( "update time     driver %.2f ns/sample ( %.2f ns per band ), double Goertzel %.2f ns/sample\n",
+            tDriver * 1e9, tDriver * 1e9 / nBands, tDouble * 1e9 );
+    printf( "state           %u bytes per band, %u bytes per bank\n",
+            ( unsigned )sizeof( T_MANOMETER_TONE ), ( unsigned )sizeof( T_MANOMETER_RIPPLE ) );
+
+    free( samples );
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+Shared-memory sample bus for Manometer Click
+
+One publisher writes decoded samples into a POSIX shared-memory ring,
+any number of readers follow it with their own cursor. Every slot
+carries the sequence number of the sample it holds; the publisher
+clears it before and sets it after writing the slot, so a reader that
+sees the same sequence before and after copying got a consistent
+sample. Neither side makes a syscall per sample.
+
+A sample is identified by the sensor address together with the
+multiplexer address and channel it sits behind ( 0 and 0 for a sensor
+on the bus itself ), as sensors behind a multiplexer share one address.
+
+    Publisher : shm_busCreate(), shm_busPublish()
+    Reader    : shm_busOpen(), shm_busRead()
+*/
+
+#ifndef _CLICK_MANOMETER_SHM_H_
+#define _CLICK_MANOMETER_SHM_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define SHM_BUS_MAGIC           0x4D414E4FUL
+#define SHM_BUS_OK              0
+#define SHM_BUS_EMPTY           1
+#define SHM_BUS_OVERRUN         2
+
+typedef struct
+{
+    uint64_t seq;
+    uint64_t timeNs;
+    uint8_t  address;
+    uint8_t  muxAddress;
+    uint8_t  muxChannel;
+    uint8_t  status;
+    uint16_t pressure;
+    uint16_t temperature;
+
+}T_shm_slot;
+
+typedef struct
+{
+    uint32_t   magic;
+    uint32_t   capacity;
+    uint64_t   head;
+    T_shm_slot slots[];
+
+}T_shm_ring;
+
+typedef struct
+{
+    T_shm_ring *ring;
+    uint64_t   cursor;
+    size_t     size;
+
+}T_shm_bus;
+
+static inline size_t shm_busSize( uint32_t capacity )
+{
+    return sizeof( T_shm_ring ) + ( size_t )capacity * sizeof( T_shm_slot );
+}
+
+/* Creates ring; capacity must be a power of two */
+static inline int shm_busCreate( T_shm_bus *bus, const char *name, uint32_t capacity )
+{
+    int fd;
+
+    bus->size = shm_busSize( capacity );
+    fd = shm_open( name, O_CREAT | O_RDWR, 0644 );
+    if ( fd < 0 )
+        return -1;
+    if ( ftruncate( fd, bus->size ) != 0 )
+    {
+        close( fd );
+        return -1;
+    }
+    bus->ring = ( T_shm_ring* )mmap( NULL, bus->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( bus->ring == MAP_FAILED )
+        return -1;
+
+    memset( bus->ring, 0, bus->size );
+    bus->ring->capacity = capacity;
+    bus->cursor = 0;
+    __atomic_store_n( &bus->ring->magic, SHM_BUS_MAGIC, __ATOMIC_RELEASE );
+
+    return 0;
+}
+
+static inline void shm_busPublish( T_shm_bus *bus, uint64_t timeNs, uint8_t address, uint8_t muxAddress,
+                                   uint8_t muxChannel, uint8_t status, uint16_t pressure, uint16_t temperature )
+{
+    T_shm_ring *ring = bus->ring;
+    uint64_t seq = ring->head;
+    T_shm_slot *slot = &ring->slots[ seq & ( ring->capacity - 1 ) ];
+
+    __atomic_store_n( &slot->seq, 0, __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    slot->timeNs = timeNs;
+    slot->address = address;
+    slot->muxAddress = muxAddress;
+    slot->muxChannel = muxChannel;
+    slot->status = status;
+    slot->pressure = pressure;
+    slot->temperature = temperature;
+    __atomic_store_n( &slot->seq, seq + 1, __ATOMIC_RELEASE );
+    __atomic_store_n( &ring->head, seq + 1, __ATOMIC_RELEASE );
+}
+
+/* Opens ring read-only; reader starts at the newest sample */
+static inline int shm_busOpen( T_shm_bus *bus, const char *name )
+{
+    T_shm_ring hdr;
+    int fd;
+
+    fd = shm_open( name, O_RDONLY, 0 );
+    if ( fd < 0 )
+        return -1;
+    if ( pread( fd, &hdr, sizeof( hdr ), 0 ) != ( ssize_t )sizeof( hdr ) || hdr.magic != SHM_BUS_MAGIC )
+    {
+        close( fd );
+        return -1;
+    }
+    bus->size = shm_busSize( hdr.capacity );
+    bus->ring = ( T_shm_ring* )mmap( NULL, bus->size, PROT_READ, MAP_SHARED, fd, 0 );
+    close( fd );
+    if ( bus->ring == MAP_FAILED )
+        return -1;
+
+    bus->cursor = __atomic_load_n( &bus->ring->head, __ATOMIC_ACQUIRE );
+
+    return 0;
+}
+
+/* Returns SHM_BUS_OK with next sample, SHM_BUS_EMPTY, or SHM_BUS_OVERRUN after skipping lost samples */
+static inline int shm_busRead( T_shm_bus *bus, T_shm_slot *out )
+{
+    T_shm_ring *ring = bus->ring;
+    uint64_t head = __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE );
+    T_shm_slot *slot;
+    uint64_t seq;
+
+    if ( bus->cursor == head )
+        return SHM_BUS_EMPTY;
+    if ( head - bus->cursor > ring->capacity )
+    {
+        bus->cursor = head - ring->capacity / 2;
+        return SHM_BUS_OVERRUN;
+    }
+
+    slot = &ring->slots[ bus->cursor & ( ring->capacity - 1 ) ];
+    seq = __atomic_load_n( &slot->seq, __ATOMIC_ACQUIRE );
+    *out = *slot;
+    __atomic_thread_fence( __ATOMIC_ACQUIRE );
+    if ( ( seq != bus->cursor + 1 ) || ( __atomic_load_n( &slot->seq, __ATOMIC_RELAXED ) != seq ) )
+    {
+        bus->cursor = __atomic_load_n( &ring->head, __ATOMIC_ACQUIRE ) - ring->capacity / 2;
+        return SHM_BUS_OVERRUN;
+    }
+    bus->cursor++;
+
+    return SHM_BUS_OK;
+}
+
+static inline void shm_busClose( T_shm_bus *bus )
+{
+    munmap( bus->ring, bus->size );
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+Shared-memory sample bus throughput benchmark
+
+    gcc -O2 Click_Manometer_shmbench.c -o Click_Manometer_shmbench
+
+---
+
+Description :
+
+Forks one reader per requested consumer and waits until every reader
+has opened the ring, then publishes N synthetic samples. Every reader
+reports samples received and lost, overruns, sequence gaps and read
+rate; the publisher reports its rate and the slot size.
+
+Unpaced, the publisher laps readers that are descheduled even briefly
+and most samples are lost, which measures the ring but not delivery.
+-r paces publishing to the given samples per second, as the daemon
+does. -b bounds the publisher instead: it waits while the slowest
+reader is a whole ring behind, giving the loss-free throughput. The
+daemon itself never waits for readers.
+
+Usage :
+
+    Click_Manometer_shmbench [-r rate] [-b] [samples] [readers]
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "Click_Manometer_shm.h"
+
+#define BENCH_SHM_NAME      "/manometer_bench"
+#define BENCH_CAPACITY      65536
+#define BENCH_READERS_MAX   64
+#define BENCH_PACE_BATCH    64
+
+/* Shared with the readers through an anonymous mapping made before fork */
+typedef struct
+{
+    uint32_t ready;
+    uint32_t go;
+    uint64_t cursor[ BENCH_READERS_MAX ];
+
+}T_bench_control;
+
+static T_bench_control *control;
+
+static double nowSec()
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void runReader( uint64_t nSamples, int index )
+{
+    T_shm_bus bus;
+    T_shm_slot slot;
+    uint64_t received = 0;
+    uint64_t overruns = 0;
+    uint64_t gaps = 0;
+    uint64_t expected = 0;
+    double t0;
+    int res;
+
+    while ( shm_busOpen( &bus, BENCH_SHM_NAME ) != 0 )
+        ;
+    bus.cursor = 0;
+    __atomic_add_fetch( &control->ready, 1, __ATOMIC_RELEASE );
+    while ( !__atomic_load_n( &control->go, __ATOMIC_ACQUIRE ) )
+        sched_yield();
+    t0 = nowSec();
+
+    while ( expected < nSamples )
+    {
+        res = shm_busRead( &bus, &slot );
+        __atomic_store_n( &control->cursor[ index ], bus.cursor, __ATOMIC_RELEASE );
+        if ( res == SHM_BUS_EMPTY )
+            continue;
+        if ( res == SHM_BUS_OVERRUN )
+        {
+            overruns++;
+            continue;
+        }
+        if ( slot.timeNs != expected )
+            gaps++;
+        expected = slot.timeNs + 1;
+        received++;
+    }
+    printf( " Reader %d:   %llu received, %llu lost, %llu overruns, %llu gaps, %.2f Msamples/s\n", index,
+            ( unsigned long long )received, ( unsigned long long )( nSamples - received ),
+            ( unsigned long long )overruns, ( unsigned long long )gaps, received / ( nowSec() - t0 ) / 1e6 );
+    shm_busClose( &bus );
+}
+
+/* Oldest cursor of all readers */
+static uint64_t slowestCursor( int nReaders )
+{
+    uint64_t cursor, slowest = ~0ULL;
+    int i;
+
+    for ( i = 0; i < nReaders; i++ )
+    {
+        cursor = __atomic_load_n( &control->cursor[ i ], __ATOMIC_ACQUIRE );
+        if ( cursor < slowest )
+            slowest = cursor;
+    }
+
+    return slowest;
+}
+
+int main( int argc, char **argv )
+{
+    T_shm_bus bus;
+    uint64_t nSamples = 10000000ULL;
+    int nReaders = 2;
+    double rate = 0;
+    int bounded = 0;
+    uint64_t cnt;
+    double t0, t1;
+    int opt;
+    int i;
+
+    while ( ( opt = getopt( argc, argv, "r:b" ) ) != -1 )
+    {
+        if ( opt == 'r' )
+            rate = atof( optarg );
+        else if ( opt == 'b' )
+            bounded = 1;
+        else
+        {
+            fprintf( stderr, "usage: %s [-r rate] [-b] [samples] [readers]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+    if ( optind < argc )
+        nSamples = strtoull( argv[ optind ], NULL, 0 );
+    if ( optind + 1 < argc )
+        nReaders = atoi( argv[ optind + 1 ] );
+    if ( ( nReaders < 1 ) || ( nReaders > BENCH_READERS_MAX ) )
+        nReaders = ( nReaders < 1 ) ? 1 : BENCH_READERS_MAX;
+
+    control = ( T_bench_control* )mmap( NULL, sizeof( T_bench_control ), PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+    if ( control == MAP_FAILED )
+    {
+        perror( "mmap" );
+        return 1;
+    }
+
+    shm_unlink( BENCH_SHM_NAME );
+    if ( shm_busCreate( &bus, BENCH_SHM_NAME, BENCH_CAPACITY ) != 0 )
+    {
+        perror( BENCH_SHM_NAME );
+        return 1;
+    }
+
+    for ( i = 0; i < nReaders; i++ )
+    {
+        if ( fork() == 0 )
+        {
+            runReader( nSamples, i );
+            return 0;
+        }
+    }
+
+    // Start barrier: every reader has its cursor at sample 0
+    while ( __atomic_load_n( &control->ready, __ATOMIC_ACQUIRE ) < ( uint32_t )nReaders )
+        sched_yield();
+    __atomic_store_n( &control->go, 1, __ATOMIC_RELEASE );
+
+    t0 = nowSec();
+    for ( cnt = 0; cnt < nSamples; cnt++ )
+    {
+        if ( ( rate > 0 ) && ( cnt % BENCH_PACE_BATCH == 0 ) )
+            while ( nowSec() - t0 < cnt / rate )
+                ;
+        if ( bounded )
+            while ( cnt - slowestCursor( nReaders ) >= BENCH_CAPACITY )
+                ;
+        shm_busPublish( &bus, cnt, 0x28, 0, 0, 0, ( uint16_t )cnt & 0x3FFF, 0x400 );
+    }
+    t1 = nowSec();
+
+    while ( wait( NULL ) > 0 )
+        ;
+
+    printf( " Publisher:  %.2f Msamples/s%s, %u-byte slots, %u-slot ring\n", nSamples / ( t1 - t0 ) / 1e6,
+            bounded ? " bounded" : ( ( rate > 0 ) ? " paced" : "" ), ( unsigned )sizeof( T_shm_slot ), BENCH_CAPACITY );
+    munmap( control, sizeof( T_bench_control ) );
+    shm_busClose( &bus );
+    shm_unlink( BENCH_SHM_NAME );
+
+    return 0;
+}
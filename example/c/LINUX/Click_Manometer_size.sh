@@ -0,0 +1,78 @@
+#!/bin/sh
+#
+# Driver size report for Manometer Click
+#
+#     sh Click_Manometer_size.sh [-v] [extra compiler flags]
+#
+# ---
+#
+# Description :
+#
+# Compiles ../../../library/__manometer_driver.c once per profile and
+# prints text, data, bss and read-only constant bytes of each object, so a
+# change can be checked against the footprint before it reaches a target.
+# With -v the largest functions of every profile are listed as well.
+#
+# CC, CFLAGS, SIZE and NM select the toolchain, for a target size use the
+# cross toolchain, e.g.
+#
+#     CC=arm-none-eabi-gcc SIZE=arm-none-eabi-size NM=arm-none-eabi-nm \
+#     CFLAGS="-Os -mcpu=cortex-m3 -mthumb" sh Click_Manometer_size.sh
+#
+# The mikroC compilers report the same figures in their statistics window.
+#
+# Usage :
+#
+#     sh Click_Manometer_size.sh [-v] [extra compiler flags]
+#
+#     default gcc -Os, profiles default, I2C, SPI, minimal I2C, minimal SPI,
+#     LUT and trace
+#
+
+CC=${CC:-gcc}
+CFLAGS=${CFLAGS:--Os}
+SIZE=${SIZE:-size}
+NM=${NM:-nm}
+
+LIBRARY=$( dirname "$0" )/../../../library
+OBJECT=${TMPDIR:-/tmp}/manometer_size.$$.o
+
+VERBOSE=0
+if [ "$1" = "-v" ]; then
+    VERBOSE=1
+    shift
+fi
+
+# Bare target build: no Linux HAL, stand-ins for the mikroC HAL symbols
+HOST="-U__linux__ -DEND_MODE_STOP=0 -DEND_MODE_RESTART=1 -DDelay_1ms()=((void)0)"
+
+report()
+{
+    name=$1
+    shift
+
+    if ! $CC $CFLAGS $HOST "$@" -I"$LIBRARY" -c "$LIBRARY/__manometer_driver.c" -o "$OBJECT" 2> /dev/null; then
+        printf "%-24s build failed\n" "$name"
+        return 1
+    fi
+
+    # Berkeley format: text data bss dec hex filename
+    set -- $( $SIZE "$OBJECT" | tail -n 1 )
+    rodata=$( $NM -S -t d "$OBJECT" | awk '$3 ~ /^[rR]$/ { n += $2 } END { print n + 0 }' )
+    printf "%-24s %7s %7s %7s %9s\n" "$name" "$1" "$2" "$3" "$rodata"
+
+    if [ $VERBOSE -eq 1 ]; then
+        $NM -S -t d --size-sort -r "$OBJECT" | awk '$3 ~ /^[tT]$/ { printf "    %-36s %6d\n", $4, $2 }' | head -n 10
+    fi
+}
+
+printf "%-24s %7s %7s %7s %9s\n" "profile" "text" "data" "bss" "constants"
+
+report "default ( I2C )"   "$@"
+report "SPI"               -D__MANOMETER_DRV_SPI__ "$@"
+report "minimal ( I2C )"   -D__MANOMETER_MINIMAL__ "$@"
+report "minimal ( SPI )"   -D__MANOMETER_MINIMAL__ -D__MANOMETER_DRV_SPI__ "$@"
+report "LUT"               -D__MANOMETER_LUT__ "$@"
+report "trace"             -D__MANOMETER_TRACE__ "$@"
+
+rm -f "$OBJECT"
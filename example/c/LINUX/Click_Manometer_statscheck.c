@@ -0,0 +1,135 @@
+/*
+Streaming statistics check for Manometer Click
+
+    gcc -O2 -I../../../library Click_Manometer_statscheck.c ../../../library/__manometer_driver.c -o Click_Manometer_statscheck -lm
+
+---
+
+Description :
+
+Feeds whole windows of pressure counts to manometer_statsUpdate() and
+compares manometer_statsGetWindow() with the window statistics computed
+in double precision, for window sizes from 2 to 65535 samples:
+
+- noise       uniform counts around mid-scale
+- offset      first sample at 100 counts, the rest at 16000 +- 2, so the
+              window reference is far from the mean and the spread small
+- step        first sample at full scale, the rest at 0
+- constant    every sample equal, standard deviation must be exactly 0
+
+Mean and standard deviation must agree to 1e-6 relative ( 1e-6 mbar
+absolute near zero ), minimum and maximum exactly. Every mismatch is
+listed and the exit status is 0 only when all cases pass.
+
+Usage :
+
+    Click_Manometer_statscheck
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "__manometer_driver.h"
+
+#define CHECK_MBAR          ( 4.177 / 13107.0 * 1000.0 )
+#define CHECK_TOL           1e-6
+
+static const uint16_t windows[ 4 ] = { 2, 60, 4096, 65535 };
+static const char *patterns[ 4 ] = { "noise", "offset", "step", "constant" };
+
+static int failures;
+
+static int agrees( double actual, double expected )
+{
+    return fabs( actual - expected ) <= CHECK_TOL * ( fabs( expected ) > 1.0 ? fabs( expected ) : 1.0 );
+}
+
+static uint16_t sample( int pattern, uint32_t i, uint32_t *seed )
+{
+    *seed = *seed * 1103515245 + 12345;
+
+    if ( pattern == 0 )
+        return 8000 + ( *seed >> 16 ) % 1001;
+    if ( pattern == 1 )
+        return ( i == 0 ) ? 100 : 15998 + ( *seed >> 16 ) % 5;
+    if ( pattern == 2 )
+        return ( i == 0 ) ? 16383 : 0;
+
+    return 12345;
+}
+
+static void check( int ok, uint16_t window, int pattern, const char *what, double expected, double actual )
+{
+    if ( ok )
+        return;
+
+    printf( "FAIL  window %5u %-8s %-6s expected %.6f, got %.6f\n", window, patterns[ pattern ], what, expected, actual );
+    failures++;
+}
+
+int main( void )
+{
+    T_MANOMETER_STATS stats;
+    T_MANOMETER_STATS_RESULT result;
+    T_MANOMETER_DEQUE_ITEM *minBuf, *maxBuf;
+    uint16_t *counts;
+    uint16_t window, lo, hi;
+    uint32_t seed, i;
+    double mean, variance, stddev;
+    int w, pattern;
+
+    minBuf = malloc( 65535 * sizeof( T_MANOMETER_DEQUE_ITEM ) );
+    maxBuf = malloc( 65535 * sizeof( T_MANOMETER_DEQUE_ITEM ) );
+    counts = malloc( 65535 * sizeof( uint16_t ) );
+    if ( ( minBuf == NULL ) || ( maxBuf == NULL ) || ( counts == NULL ) )
+        return 1;
+
+    for ( w = 0; w < 4; w++ )
+    {
+        for ( pattern = 0; pattern < 4; pattern++ )
+        {
+            window = windows[ w ];
+            seed = 1;
+            manometer_statsInit( &stats, window, minBuf, maxBuf );
+            mean = 0;
+            lo = 0xFFFF;
+            hi = 0;
+            for ( i = 0; i < window; i++ )
+            {
+                counts[ i ] = sample( pattern, i, &seed );
+                manometer_statsUpdate( &stats, counts[ i ] );
+                mean += counts[ i ];
+                if ( counts[ i ] < lo )
+                    lo = counts[ i ];
+                if ( counts[ i ] > hi )
+                    hi = counts[ i ];
+            }
+            mean /= window;
+            variance = 0;
+            for ( i = 0; i < window; i++ )
+                variance += ( counts[ i ] - mean ) * ( counts[ i ] - mean );
+            stddev = sqrt( variance / ( window - 1 ) ) * CHECK_MBAR;
+            mean = ( mean - 1638.0 ) * CHECK_MBAR;
+
+            manometer_statsGetWindow( &stats, &result );
+            check( agrees( result.mean, mean ), window, pattern, "mean", mean, result.mean );
+            check( ( pattern == 3 ) ? ( result.stddev == 0.0 ) : agrees( result.stddev, stddev ),
+                   window, pattern, "stddev", stddev, result.stddev );
+            check( manometer_statsGetMin( &stats ) == lo, window, pattern, "min", lo, manometer_statsGetMin( &stats ) );
+            check( manometer_statsGetMax( &stats ) == hi, window, pattern, "max", hi, manometer_statsGetMax( &stats ) );
+        }
+    }
+
+    printf( " Windows:     2 to 65535 samples, %d patterns\n", 4 );
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+
+    free( minBuf );
+    free( maxBuf );
+    free( counts );
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+/*
+Temperature conversion check for Manometer Click
+
+    gcc -O2 -I../../../library Click_Manometer_tempcheck.c ../../../library/__manometer_driver.c -o Click_Manometer_tempcheck -lm
+    gcc -O2 -D__MANOMETER_LUT__ -I../../../library Click_Manometer_tempcheck.c ../../../library/__manometer_driver.c -o Click_Manometer_tempcheck_lut -lm
+    gcc -O2 -D__MANOMETER_MINIMAL__ -I../../../library Click_Manometer_tempcheck.c ../../../library/__manometer_driver.c -o Click_Manometer_tempcheck_min -lm
+
+---
+
+Description :
+
+Runs every 11-bit temperature count through the driver conversions and
+compares them with the datasheet transfer function
+
+    T = count * 200 / 2047 - 50 [ degC ]
+
+evaluated in double precision:
+
+- manometer_countToCentiCelsius()    exact after rounding to 0.01 degC,
+                                     within 0.01 degC in table mode
+- manometer_countToTemperature()     within 1e-4 degC, within 0.01 degC
+                                     in table mode ( not in the minimal
+                                     profile )
+
+The centi-degree result must also rise with the count, and both
+conversions must ignore the bits above the 11-bit count. Build with -D__MANOMETER_LUT__ to check the
+table ( __manometer_lut.h ) instead of the arithmetic. Every mismatch is
+listed, up to 20, and the exit status is 0 only when all counts pass.
+
+Usage :
+
+    Click_Manometer_tempcheck
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "__manometer_driver.h"
+
+#define CHECK_COUNTS        2048
+#define CHECK_LISTED        20
+
+#ifdef   __MANOMETER_LUT__
+#define CHECK_CENTI_TOL     1
+#define CHECK_FLOAT_TOL     ( 0.01 + 1e-4 )
+#else
+#define CHECK_CENTI_TOL     0
+#define CHECK_FLOAT_TOL     1e-4
+#endif
+
+static int failures;
+
+static void mismatch( const char *path, uint16_t count, double expected, double actual )
+{
+    if ( failures < CHECK_LISTED )
+        printf( "FAIL  %-6s count %4u: expected %.4f, got %.4f\n", path, count, expected, actual );
+    failures++;
+}
+
+/* Datasheet transfer function [ degC ] */
+static double reference( uint16_t count )
+{
+    return count * 200.0 / 2047.0 - 50.0;
+}
+
+int main( void )
+{
+    uint16_t count;
+    int16_t centi, previous = -32768;
+    long expected;
+    int centiWorst = 0;
+#ifndef  __MANOMETER_MINIMAL__
+    double degC, floatWorst = 0;
+#endif
+
+    for ( count = 0; count < CHECK_COUNTS; count++ )
+    {
+        // Ties cannot occur: 2047 is odd and only divides 20000 * count at both ends
+        expected = lround( reference( count ) * 100.0 );
+        centi = manometer_countToCentiCelsius( count );
+        if ( labs( centi - expected ) > CHECK_CENTI_TOL )
+            mismatch( "centi", count, expected / 100.0, centi / 100.0 );
+        if ( labs( centi - expected ) > centiWorst )
+            centiWorst = labs( centi - expected );
+        if ( centi < previous )
+            mismatch( "rising", count, previous / 100.0, centi / 100.0 );
+        previous = centi;
+        if ( manometer_countToCentiCelsius( count | 0xF800 ) != centi )
+            mismatch( "mask", count, centi / 100.0, manometer_countToCentiCelsius( count | 0xF800 ) / 100.0 );
+
+#ifndef  __MANOMETER_MINIMAL__
+        degC = manometer_countToTemperature( count );
+        if ( fabs( degC - reference( count ) ) > CHECK_FLOAT_TOL )
+            mismatch( "float", count, reference( count ), degC );
+        if ( fabs( degC - reference( count ) ) > floatWorst )
+            floatWorst = fabs( degC - reference( count ) );
+        if ( manometer_countToTemperature( count | 0xF800 ) != degC )
+            mismatch( "fmask", count, degC, manometer_countToTemperature( count | 0xF800 ) );
+#endif
+    }
+
+#ifdef   __MANOMETER_LUT__
+    printf( " Mode:        table ( __manometer_lut.h )\n" );
+#else
+    printf( " Mode:        arithmetic\n" );
+#endif
+    printf( " Counts:      %d\n", CHECK_COUNTS );
+    printf( " Centi:       %d x 0.01 degC worst after rounding\n", centiWorst );
+#ifndef  __MANOMETER_MINIMAL__
+    printf( " Float:       %.2e degC worst\n", floatWorst );
+#endif
+    printf( "%s\n", failures ? "FAIL" : "PASS" );
+
+    return failures ? 1 : 0;
+}
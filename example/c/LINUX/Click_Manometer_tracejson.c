@@ -0,0 +1,227 @@
+/*
+Bus trace exporter for Manometer Click
+
+    gcc -O2 Click_Manometer_tracejson.c -o Click_Manometer_tracejson
+
+---
+
+Description :
+
+Converts a bus trace dump ( __MANOMETER_TRACE__, manometer_traceGetEvent() )
+to Chrome trace JSON, viewable in chrome://tracing or ui.perfetto.dev.
+Each bus address gets its own track. Every transaction is one slice
+from start to stop with its write and read phases nested below, each
+phase from its event ( stamped when the HAL call started ) to the next
+event of the transaction; the
+slice arguments hold the driver result and the idle gap since the
+previous transaction on the same address. A latency and gap summary is
+written to standard error.
+
+Usage :
+
+    Click_Manometer_tracejson [-s us] < dump > trace.json
+
+    -s    microseconds per time source unit      ( default 1 )
+
+Dump has one event per line, other lines are skipped:
+
+    <time> <kind> <address> <bytes> <result>
+
+with kind 0 start, 1 write, 2 read, 3 stop, as _MANOMETER_TRACE_*, and
+result the HAL result ( negative on error ) or, on stop, the driver
+result.
+
+*/
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#define TRACE_START     0
+#define TRACE_WRITE     1
+#define TRACE_READ      2
+#define TRACE_STOP      3
+
+#define TRACE_PHASES    8
+
+typedef struct
+{
+    int                kind;
+    int                nBytes;
+    int                result;
+    unsigned long long begin;
+    unsigned long long end;
+
+}T_phase;
+
+typedef struct
+{
+    int                open;
+    int                named;
+    int                reads;
+    int                nPhases;
+    T_phase            phases[ TRACE_PHASES ];
+    unsigned long long start;
+    unsigned long long last;
+    unsigned long long lastStop;
+    int                stopped;
+
+}T_track;
+
+static T_track tracks[ 256 ];
+static double scale = 1.0;
+static int first = 1;
+
+static unsigned long nTransactions, nGaps;
+static double latencySum, latencyMax, gapSum, gapMax;
+
+static void emit( const char *args, const char *name, int address, unsigned long long ts, unsigned long long dur )
+{
+    printf( "%s\n  { \"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, \"args\": { ",
+            first ? "" : ",", name, address, ts * scale, dur * scale );
+    printf( "%s", args );
+    printf( " } }" );
+    first = 0;
+}
+
+static void closeTransaction( int address, unsigned long long end, int result, int complete )
+{
+    T_track *track = &tracks[ address ];
+    char args[ 128 ];
+    double latency = ( end - track->start ) * scale;
+    int i;
+
+    if ( track->stopped )
+        snprintf( args, sizeof( args ), "\"result\": %d, \"gap_us\": %.3f%s", result,
+                  ( track->start - track->lastStop ) * scale, complete ? "" : ", \"incomplete\": 1" );
+    else
+        snprintf( args, sizeof( args ), "\"result\": %d%s", result, complete ? "" : ", \"incomplete\": 1" );
+    emit( args, track->reads ? "read transaction" : "write transaction", address, track->start, end - track->start );
+
+    for ( i = 0; i < track->nPhases; i++ )
+    {
+        snprintf( args, sizeof( args ), "\"bytes\": %d, \"result\": %d", track->phases[ i ].nBytes, track->phases[ i ].result );
+        emit( args, ( track->phases[ i ].kind == TRACE_READ ) ? "read" : "write", address,
+              track->phases[ i ].begin, track->phases[ i ].end - track->phases[ i ].begin );
+    }
+
+    if ( !complete )
+    {
+        track->open = 0;
+        return;
+    }
+
+    nTransactions++;
+    latencySum += latency;
+    if ( latency > latencyMax )
+        latencyMax = latency;
+    if ( track->stopped && track->reads )
+    {
+        nGaps++;
+        gapSum += ( track->start - track->lastStop ) * scale;
+        if ( ( track->start - track->lastStop ) * scale > gapMax )
+            gapMax = ( track->start - track->lastStop ) * scale;
+    }
+    track->lastStop = end;
+    track->stopped = 1;
+    track->open = 0;
+}
+
+int main( int argc, char **argv )
+{
+    char line[ 128 ];
+    unsigned long raw, lastRaw = 0;
+    unsigned long long time = 0;
+    unsigned int kind, address, nBytes;
+    int result;
+    T_track *track;
+    T_phase *phase;
+    int opt;
+    int started = 0;
+
+    while ( ( opt = getopt( argc, argv, "s:" ) ) != -1 )
+    {
+        if ( opt != 's' )
+        {
+            fprintf( stderr, "usage: %s [-s us] < dump > trace.json\n", argv[ 0 ] );
+            return 1;
+        }
+        scale = atof( optarg );
+    }
+
+    printf( "{ \"displayTimeUnit\": \"ns\", \"traceEvents\": [" );
+    printf( "\n  { \"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": { \"name\": \"Manometer bus\" } }" );
+    first = 0;
+
+    while ( fgets( line, sizeof( line ), stdin ) != NULL )
+    {
+        if ( sscanf( line, "%lu %u %u %u %d", &raw, &kind, &address, &nBytes, &result ) != 5 )
+            continue;
+        if ( ( kind > TRACE_STOP ) || ( address > 255 ) )
+            continue;
+
+        // 32-bit time source wraps, events are in time order
+        if ( started )
+            time += ( unsigned long )( ( uint32_t )raw - ( uint32_t )lastRaw );
+        lastRaw = raw;
+        started = 1;
+
+        track = &tracks[ address ];
+        if ( !track->named )
+        {
+            printf( ",\n  { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, \"args\": { \"name\": \"0x%02X\" } }",
+                    address, address );
+            track->named = 1;
+        }
+
+        if ( kind == TRACE_START )
+        {
+            if ( track->open )
+                closeTransaction( address, track->last, 0, 0 );
+            track->open = 1;
+            track->reads = 0;
+            track->nPhases = 0;
+            track->start = time;
+            track->last = time;
+            continue;
+        }
+        if ( !track->open )
+            continue;
+
+        // Event marks the start of its phase and the end of the previous one
+        if ( track->nPhases > 0 )
+            track->phases[ track->nPhases - 1 ].end = time;
+
+        if ( kind == TRACE_STOP )
+        {
+            closeTransaction( address, time, result, 1 );
+            continue;
+        }
+
+        if ( track->nPhases < TRACE_PHASES )
+        {
+            phase = &track->phases[ track->nPhases++ ];
+            phase->kind = kind;
+            phase->nBytes = nBytes;
+            phase->result = result;
+            phase->begin = time;
+            phase->end = time;
+        }
+        if ( kind == TRACE_READ )
+            track->reads = 1;
+        track->last = time;
+    }
+
+    printf( "\n] }\n" );
+
+    if ( nTransactions )
+        fprintf( stderr, "transactions   %lu, latency %.1f us mean, %.1f us worst\n",
+                 nTransactions, latencySum / nTransactions, latencyMax );
+    if ( nGaps )
+        fprintf( stderr, "read gaps      %lu, %.1f us mean, %.1f us worst\n", nGaps, gapSum / nGaps, gapMax );
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+#ifndef _MANOMETER_T_
+#define _MANOMETER_T_
+
+#include "stdint.h"
+
+#ifndef _MANOMETER_H_
+
+#define T_MANOMETER_P const uint8_t* 
+
+#endif
+#endif
\ No newline at end of file
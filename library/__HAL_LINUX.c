@@ -0,0 +1,171 @@
+/*
+    __HAL_LINUX.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_LINUX.c
+@brief  Linux i2c-dev HAL backend
+
+Bus object is an open /dev/i2c-N file descriptor. Write with restart is
+held back and sent together with the following read as one combined
+I2C_RDWR transaction, so a sensor read costs a single ioctl. Every
+ioctl is counted in the bus object ( __HAL_LINUX.h ).
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "__HAL_LINUX.h"
+
+#ifndef END_MODE_STOP
+#define END_MODE_STOP               0
+#endif
+#ifndef END_MODE_RESTART
+#define END_MODE_RESTART            1
+#endif
+
+#define HAL_LINUX_PENDING_MAX       8
+
+static void Delay_1ms()
+{
+    usleep(1000);
+}
+
+#ifdef __HAL_I2C__
+
+static T_hal_linuxBus *hal_linux_bus = NULL;
+static int      hal_linux_fd = -1;
+static uint8_t  hal_linux_pendingAddr;
+static uint8_t  hal_linux_pendingBuf[ HAL_LINUX_PENDING_MAX ];
+static uint16_t hal_linux_pendingLen = 0;
+static uint8_t  hal_linux_pending = 0;
+
+static int hal_linux_transfer(struct i2c_msg *msgs, uint32_t nMsgs)
+{
+    struct i2c_rdwr_ioctl_data xfer;
+
+    xfer.msgs = msgs;
+    xfer.nmsgs = nMsgs;
+    hal_linux_bus->nIoctl++;
+
+    if (ioctl(hal_linux_fd, I2C_RDWR, &xfer) < 0)
+        return -1;
+
+    return 0;
+}
+
+static void hal_i2cMap(T_HAL_P i2cObj)
+{
+    hal_linux_bus = (T_hal_linuxBus*)i2cObj;
+    hal_linux_fd = hal_linux_bus->fd;
+    hal_linux_pending = 0;
+}
+
+static int hal_i2cStart(void)
+{
+    hal_linux_pending = 0;
+
+    return (hal_linux_fd < 0) ? -1 : 0;
+}
+
+static int hal_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    struct i2c_msg msg;
+
+    if ((endMode == END_MODE_RESTART) && (nBytes <= HAL_LINUX_PENDING_MAX))
+    {
+        memcpy(hal_linux_pendingBuf, pBuf, nBytes);
+        hal_linux_pendingAddr = slaveAddress;
+        hal_linux_pendingLen = nBytes;
+        hal_linux_pending = 1;
+
+        return 0;
+    }
+
+    msg.addr = slaveAddress;
+    msg.flags = 0;
+    msg.len = nBytes;
+    msg.buf = pBuf;
+
+    return hal_linux_transfer(&msg, 1);
+}
+
+static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    struct i2c_msg msgs[ 2 ];
+    uint32_t nMsgs = 0;
+
+    (void)endMode;
+
+    if (hal_linux_pending)
+    {
+        msgs[ nMsgs ].addr = hal_linux_pendingAddr;
+        msgs[ nMsgs ].flags = 0;
+        msgs[ nMsgs ].len = hal_linux_pendingLen;
+        msgs[ nMsgs ].buf = hal_linux_pendingBuf;
+        nMsgs++;
+        hal_linux_pending = 0;
+    }
+
+    msgs[ nMsgs ].addr = slaveAddress;
+    msgs[ nMsgs ].flags = I2C_M_RD;
+    msgs[ nMsgs ].len = nBytes;
+    msgs[ nMsgs ].buf = pBuf;
+    nMsgs++;
+
+    return hal_linux_transfer(msgs, nMsgs);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*
+  __HAL_LINUX.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
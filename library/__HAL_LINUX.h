@@ -0,0 +1,39 @@
+/*
+    __HAL_LINUX.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_LINUX.h
+@brief  Linux i2c-dev bus object
+
+Shared by the Linux HAL backend ( __HAL_LINUX.c ) and host programs
+that open the bus.
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _HAL_LINUX_H_
+#define _HAL_LINUX_H_
+
+/**
+ * @brief Linux I2C bus object
+ *
+ * fd     - file descriptor of opened /dev/i2c-N
+ * nIoctl - I2C_RDWR system calls issued by the HAL
+ */
+typedef struct
+{
+    int           fd;
+    unsigned long nIoctl;
+
+}T_hal_linuxBus;
+
+#endif
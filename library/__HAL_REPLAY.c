@@ -0,0 +1,152 @@
+/*
+    __HAL_REPLAY.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_REPLAY.c
+@brief  Recorded frame replay HAL backend
+
+Selected with __HAL_REPLAY__ on a host build. Bus object is an open
+recording with one sensor frame per line:
+
+    <time> <frame>
+
+time is any non-decreasing integer ( microseconds by convention ) and
+frame the 4 sensor bytes as 8 hex digits, or - for a read that failed
+when recorded; other lines are skipped. Every bus read returns the next
+recorded frame, or a bus error for a failed one, and stores its time in
+the bus object; writes are accepted and ignored. Delays return at once, so the driver runs as fast
+as the host allows. At the end of the recording reads fail and the
+end flag of the bus object is set.
+*/
+/* -------------------------------------------------------------------------- */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "__HAL_REPLAY.h"
+
+#ifndef END_MODE_STOP
+#define END_MODE_STOP               0
+#endif
+#ifndef END_MODE_RESTART
+#define END_MODE_RESTART            1
+#endif
+
+static void Delay_1ms()
+{
+}
+
+#ifdef __HAL_I2C__
+
+static T_hal_replayBus *hal_replay_bus = NULL;
+
+static void hal_i2cMap(T_HAL_P i2cObj)
+{
+    hal_replay_bus = (T_hal_replayBus*)i2cObj;
+}
+
+static int hal_i2cStart(void)
+{
+    return (hal_replay_bus == NULL) ? -1 : 0;
+}
+
+static int hal_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    (void)slaveAddress;
+    (void)pBuf;
+    (void)nBytes;
+    (void)endMode;
+
+    return 0;
+}
+
+static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    unsigned long long time;
+    unsigned long frame;
+    uint8_t bytes[ 4 ];
+    char line[ 64 ];
+    char mark[ 2 ];
+    int nField;
+    int failed;
+
+    (void)slaveAddress;
+    (void)endMode;
+
+    if (hal_replay_bus->end)
+        return -1;
+    do
+    {
+        if (fgets(line, sizeof(line), hal_replay_bus->file) == NULL)
+        {
+            hal_replay_bus->end = 1;
+            return -1;
+        }
+        nField = sscanf(line, "%llu %lx", &time, &frame);
+        failed = (nField == 1) && (sscanf(line, "%*s %1[-]", mark) == 1);
+    }
+    while ((nField != 2) && !failed);
+
+    hal_replay_bus->time = time;
+    if (failed)
+        return -1;
+
+    bytes[ 0 ] = (uint8_t)(frame >> 24);
+    bytes[ 1 ] = (uint8_t)(frame >> 16);
+    bytes[ 2 ] = (uint8_t)(frame >> 8);
+    bytes[ 3 ] = (uint8_t)frame;
+    memcpy(pBuf, bytes, (nBytes < 4) ? nBytes : 4);
+
+    return 0;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*
+  __HAL_REPLAY.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
@@ -0,0 +1,43 @@
+/*
+    __HAL_REPLAY.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_REPLAY.h
+@brief  Recorded frame replay bus object
+
+Shared by the replay HAL backend ( __HAL_REPLAY.c ) and host programs
+that open the recording.
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _HAL_REPLAY_H_
+#define _HAL_REPLAY_H_
+
+#include <stdio.h>
+
+/**
+ * @brief Replay bus object
+ *
+ * file - opened recording
+ * time - time of the frame returned by the last read
+ * end  - set when the recording is exhausted
+ */
+typedef struct
+{
+    FILE               *file;
+    unsigned long long time;
+    int                end;
+
+}T_hal_replayBus;
+
+#endif
@@ -0,0 +1,123 @@
+/*
+    __HAL_SIM.c
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_SIM.c
+@brief  Simulated I2C bus HAL backend
+
+Selected with __HAL_SIM__ on a host build. Bus object ( __HAL_SIM.h )
+holds a virtual clock and a device model provided by the application.
+Start, every byte ( address byte included, 9 bits with acknowledge )
+and stop advance the virtual time by their bit time at the bus clock.
+Reads and writes are passed to the device model, whose return value is
+the acknowledge. Delays advance the virtual time instead of sleeping,
+so long simulations run as fast as the host allows.
+*/
+/* -------------------------------------------------------------------------- */
+
+#include "__HAL_SIM.h"
+
+#ifndef END_MODE_STOP
+#define END_MODE_STOP               0
+#endif
+#ifndef END_MODE_RESTART
+#define END_MODE_RESTART            1
+#endif
+
+static T_hal_simBus *hal_sim_bus = NULL;
+
+static void Delay_1ms()
+{
+    if (hal_sim_bus != NULL)
+        hal_sim_bus->time += 1000000ULL;
+}
+
+#ifdef __HAL_I2C__
+
+static void hal_sim_advance(uint32_t bits)
+{
+    hal_sim_bus->time += (unsigned long long)bits * 1000000000ULL / hal_sim_bus->speed;
+}
+
+static void hal_i2cMap(T_HAL_P i2cObj)
+{
+    hal_sim_bus = (T_hal_simBus*)i2cObj;
+}
+
+static int hal_i2cStart(void)
+{
+    if (hal_sim_bus == NULL)
+        return -1;
+
+    hal_sim_advance(1);
+    hal_sim_bus->nStart++;
+
+    return 0;
+}
+
+static int hal_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    hal_sim_advance(9 * (nBytes + 1) + ((endMode == END_MODE_STOP) ? 1 : 0));
+    hal_sim_bus->nBytes += nBytes;
+
+    return hal_sim_bus->device(hal_sim_bus->context, slaveAddress, pBuf, nBytes, 0);
+}
+
+static int hal_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    hal_sim_advance(9 * (nBytes + 1) + ((endMode == END_MODE_STOP) ? 1 : 0));
+    hal_sim_bus->nBytes += nBytes;
+
+    return hal_sim_bus->device(hal_sim_bus->context, slaveAddress, pBuf, nBytes, 1);
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*
+  __HAL_SIM.c
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
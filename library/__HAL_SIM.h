@@ -0,0 +1,59 @@
+/*
+    __HAL_SIM.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __HAL_SIM.h
+@brief  Simulated I2C bus object
+
+Shared by the simulated HAL backend ( __HAL_SIM.c ) and host programs
+that create the bus and model the devices on it.
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _HAL_SIM_H_
+#define _HAL_SIM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Simulated device model
+ *
+ * Called with the context of the bus object for every write ( isRead 0 )
+ * and read ( isRead 1 ); fills pBuf on read. Returns 0 when the device
+ * acknowledges, -1 otherwise.
+ */
+typedef int (*T_hal_simDeviceFp)(void *context, uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t isRead);
+
+/**
+ * @brief Simulated bus object
+ *
+ * device  - device model
+ * context - passed to the device model
+ * speed   - bus clock [ Hz ]
+ * time    - virtual time [ ns ]
+ * nStart  - start conditions issued
+ * nBytes  - data bytes transferred
+ */
+typedef struct
+{
+    T_hal_simDeviceFp  device;
+    void               *context;
+    uint32_t           speed;
+    unsigned long long time;
+    unsigned long      nStart;
+    unsigned long      nBytes;
+
+}T_hal_simBus;
+
+#endif
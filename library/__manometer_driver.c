@@ -11,19 +11,55 @@
 
 ----------------------------------------------------------------------------- */
 
+// Host builds: POSIX and BSD declarations used by the Linux HAL backends
+#ifdef   __linux__
+#ifndef  _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+#endif
+
 #include "__manometer_driver.h"
 #include "__manometer_hal.c"
+#ifdef   __MANOMETER_LUT__
+#include "__manometer_lut.h"
+#endif
 
 /* ------------------------------------------------------------------- MACROS */
 
+#define _MANOMETER_SPEED_VERIFY_READS  3
+
+// Longest sample gap [ ms ] the pressure filter predicts across
+#define _MANOMETER_KALMAN_GAP_MAX      10000
 
 
 /* ---------------------------------------------------------------- VARIABLES */
 
 #ifdef   __MANOMETER_DRV_I2C__
 static uint8_t _slaveAddress;
+static uint32_t _busSpeed = 0;
+static uint32_t _busSpeedSelected = 0;
+static T_MANOMETER_BUS_SPEED_FP _busSpeedHandler = 0;
+static uint8_t _muxAddress = 0;
+static uint8_t _muxChannel = 0xFF;
+static T_MANOMETER_QUEUE *_queue = 0;
+static T_MANOMETER_SENSOR *_sensor = 0;
+#endif
+
+static T_MANOMETER_BUS_LOCK_FP _busLockFp = 0;
+static T_MANOMETER_BUS_UNLOCK_FP _busUnlockFp = 0;
+static uint8_t _busPriority = 0;
+static T_MANOMETER_TIME_FP _timeFp = 0;
+#ifdef   __MANOMETER_TRACE__
+static T_MANOMETER_TRACE *_trace = 0;
+static T_MANOMETER_TRACE_EVENT *_traceLast = 0;
 #endif
 
+static uint8_t _tempDecimation = 1;
+static uint8_t _tempCycle = 0;
+static uint16_t _lastTemperature = 0;
+
+// Minimal profile takes the codes as macros from __manometer_driver.h
+#ifndef  __MANOMETER_MINIMAL__
 // ADC reset command
 const uint8_t _MANOMETER_CMD_RESET       = 0x1E;
 // ADC read command
@@ -53,14 +89,347 @@ const uint8_t _MANOMETER_OUTPUT_ADDRESS  = 0x38;
 // I2C register address
 const uint8_t _MANOMETER_I2C_ADDRESS     = 0x38;
 
+// Sensor status bits
+const uint8_t _MANOMETER_STATUS_NORMAL     = 0x00;
+const uint8_t _MANOMETER_STATUS_COMMAND    = 0x01;
+const uint8_t _MANOMETER_STATUS_STALE      = 0x02;
+const uint8_t _MANOMETER_STATUS_DIAGNOSTIC = 0x03;
+
+// Driver return codes
+const uint8_t _MANOMETER_OK              = 0x00;
+const uint8_t _MANOMETER_ERR_BUS         = 0x01;
+const uint8_t _MANOMETER_ERR_BUSY        = 0x02;
+const uint8_t _MANOMETER_ERR_PARAM       = 0x03;
+const uint8_t _MANOMETER_ERR_TIMEOUT     = 0x04;
+
+// Values returned by read-and-convert functions when the bus read fails,
+// outside the range of any sensor count
+const float _MANOMETER_PRESSURE_ERROR          = -10000.0;
+const float _MANOMETER_TEMPERATURE_ERROR       = -300.0;
+const int32_t _MANOMETER_PRESSURE_PA_ERROR     = -1000000;
+const int16_t _MANOMETER_TEMPERATURE_CENTI_ERROR = -30000;
+
+// Burst trigger modes
+const uint8_t _MANOMETER_TRIGGER_RISING  = 0x00;
+const uint8_t _MANOMETER_TRIGGER_FALLING = 0x01;
+const uint8_t _MANOMETER_TRIGGER_SLOPE   = 0x02;
+
+// Burst capture states
+const uint8_t _MANOMETER_BURST_ARMED     = 0x00;
+const uint8_t _MANOMETER_BURST_TRIGGERED = 0x01;
+const uint8_t _MANOMETER_BURST_DONE      = 0x02;
+
+#ifdef   __MANOMETER_TRACE__
+// Traced bus events
+const uint8_t _MANOMETER_TRACE_START     = 0x00;
+const uint8_t _MANOMETER_TRACE_WRITE     = 0x01;
+const uint8_t _MANOMETER_TRACE_READ      = 0x02;
+const uint8_t _MANOMETER_TRACE_STOP      = 0x03;
+#endif
+
+#ifdef   __MANOMETER_DRV_I2C__
+// Queued transfer not served yet
+const uint8_t _MANOMETER_XFER_PENDING    = 0xFF;
+#endif
+
+// I2C clock rates supported by the sensor
+const uint32_t _MANOMETER_I2C_SPEED_FAST     = 400000;
+const uint32_t _MANOMETER_I2C_SPEED_STANDARD = 100000;
+#endif
+
 
 /* -------------------------------------------- PRIVATE FUNCTION DECLARATIONS */
 
+static uint8_t _busLock();
+static void _busUnlock();
+#ifdef   __MANOMETER_DRV_I2C__
+static void _busSetSpeed( uint32_t speed );
+#endif
+static uint8_t _readFrame( uint8_t *readReg, uint8_t nBytes );
+static void _decodeSample( uint8_t *readReg, T_MANOMETER_SAMPLE *sample );
+static uint8_t _burstIsTrigger( T_MANOMETER_BURST *burst, uint16_t pressure );
+#if defined( __MANOMETER_DRV_I2C__ ) || defined( __MANOMETER_TRACE__ )
+static uint32_t _timeNow();
+#endif
+#ifdef   __MANOMETER_TRACE__
+static void _traceEvent( uint8_t kind, uint8_t address, uint16_t nBytes, int16_t result );
+static int _traceResult( int result );
+#endif
+#ifdef   __MANOMETER_DRV_I2C__
+static uint8_t _xferRun( T_MANOMETER_XFER *xfer );
+static uint8_t _transfer( uint8_t slaveAddress, uint8_t *writeBuf, uint16_t nWrite, uint8_t *readBuf, uint16_t nRead );
+static void _queueRemove( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER *xfer );
+static uint8_t _queueServe( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER *last );
+static uint8_t _verifySpeed();
+static uint8_t _muxWrite( uint8_t muxAddress, uint8_t control );
+static uint16_t _muxKey( T_MANOMETER_SENSOR *sensor );
+#endif
+#ifndef  __MANOMETER_MINIMAL__
+static float _countToPressure( float count );
+static float _sqrt( float value );
+static void _mulWide( uint32_t a, uint32_t b, uint32_t *hi, uint32_t *lo );
+static void _dequePush( T_MANOMETER_DEQUE *q, uint16_t size, uint16_t seq, uint16_t value, uint8_t isMax );
+static float _cos( float angle );
+static int32_t _mulQ14( int32_t coeff, int32_t value );
+#endif
+#ifdef   __MANOMETER_LUT__
+static int32_t _lutInterpolate( const int32_t *table, uint16_t count, uint8_t shift );
+#endif
+static int32_t _mulShift( int32_t a, int32_t b, uint8_t shift );
+static int32_t _compPoly( int32_t *coeff, int32_t x );
 
+// Traces HAL call returning a result, stamped before the call / records event
+#ifdef   __MANOMETER_TRACE__
+#define _TRACE_CALL( kind, address, nBytes, call )    ( _traceEvent( kind, address, nBytes, 0 ), _traceResult( call ) )
+#define _TRACE( kind, address, nBytes, result )       _traceEvent( kind, address, nBytes, result )
+#else
+#define _TRACE_CALL( kind, address, nBytes, call )    ( call )
+#define _TRACE( kind, address, nBytes, result )
+#endif
 
 /* --------------------------------------------- PRIVATE FUNCTION DEFINITIONS */
 
+/* Requests bus from the application arbiter */
+static uint8_t _busLock()
+{
+    if ( ( _busLockFp != 0 ) && ( _busLockFp( _busPriority ) != 0 ) )
+        return _MANOMETER_ERR_BUSY;
+
+#ifdef   __MANOMETER_DRV_I2C__
+    // Clock of the selected sensor is set only while the bus is held
+    if ( _busSpeedSelected != 0 )
+        _busSetSpeed( _busSpeedSelected );
+#endif
+
+    return _MANOMETER_OK;
+}
+
+#ifdef   __MANOMETER_DRV_I2C__
+/* Switches bus clock through the application handler when it differs */
+static void _busSetSpeed( uint32_t speed )
+{
+    if ( ( _busSpeedHandler != 0 ) && ( speed != _busSpeed ) )
+    {
+        _busSpeedHandler( speed );
+        _busSpeed = speed;
+    }
+}
+#endif
+
+/* Returns bus to the application arbiter */
+static void _busUnlock()
+{
+    if ( _busUnlockFp != 0 )
+        _busUnlockFp();
+}
+
+/* Reads first nBytes of sensor output frame */
+static uint8_t _readFrame( uint8_t *readReg, uint8_t nBytes )
+{
+#ifdef   __MANOMETER_DRV_SPI__
+    if ( _busLock() != _MANOMETER_OK )
+        return _MANOMETER_ERR_BUSY;
+
+    _TRACE( _MANOMETER_TRACE_START, 0, 0, 0 );
+    hal_gpio_csSet( 0 );
+    _TRACE( _MANOMETER_TRACE_READ, 0, nBytes, 0 );
+    hal_spiRead( readReg, nBytes );
+    hal_gpio_csSet( 1 );
+    _TRACE( _MANOMETER_TRACE_STOP, 0, 0, _MANOMETER_OK );
+
+    _busUnlock();
+
+    return _MANOMETER_OK;
+#else
+    uint8_t writeReg[ 1 ];
+
+    writeReg[ 0 ] = _MANOMETER_OUTPUT_ADDRESS;
+
+    return _transfer( _slaveAddress, writeReg, 1, readReg, nBytes );
+#endif
+}
+
+/* Splits 4-byte output frame into status, pressure and temperature counts */
+static void _decodeSample( uint8_t *readReg, T_MANOMETER_SAMPLE *sample )
+{
+    uint16_t tmp;
+
+    sample->status = readReg[ 0 ] >> 6;
+
+    tmp = readReg[ 0 ] & 0x3F;
+    tmp <<= 8;
+    tmp |= readReg[ 1 ];
+    sample->pressure = tmp;
+
+    tmp = readReg[ 2 ];
+    tmp <<= 8;
+    tmp |= readReg[ 3 ];
+    sample->temperature = tmp >> 5;
+}
+
+/* Checks trigger condition against previous sample */
+static uint8_t _burstIsTrigger( T_MANOMETER_BURST *burst, uint16_t pressure )
+{
+    int16_t last = ( int16_t ) burst->lastPressure;
+    int16_t current = ( int16_t ) pressure;
+
+    if ( burst->count == 0 )
+        return 0;
 
+    if ( burst->triggerMode == _MANOMETER_TRIGGER_RISING )
+        return ( last < burst->level ) && ( current >= burst->level );
+
+    if ( burst->triggerMode == _MANOMETER_TRIGGER_FALLING )
+        return ( last > burst->level ) && ( current <= burst->level );
+
+    if ( burst->level >= 0 )
+        return ( current - last ) >= burst->level;
+
+    return ( current - last ) <= burst->level;
+}
+
+#ifndef  __MANOMETER_MINIMAL__
+/* Converts raw pressure count to mbar */
+static float _countToPressure( float count )
+{
+    return ( count - 1638.00 ) * ( ( 4.177 / 13107.00 ) * 1000.00 );
+}
+
+/* Square root by Newton iteration, avoids math library dependency */
+static float _sqrt( float value )
+{
+    float root = 1.0;
+    float scaled = value;
+    uint8_t cnt;
+
+    if ( value <= 0.0 )
+        return 0.0;
+
+    while ( scaled > 4.0 )
+    {
+        scaled /= 4.0;
+        root *= 2.0;
+    }
+    while ( scaled < 0.25 )
+    {
+        scaled *= 4.0;
+        root /= 2.0;
+    }
+    for ( cnt = 0; cnt < 6; cnt++ )
+        root = ( root + value / root ) / 2.0;
+
+    return root;
+}
+
+/* Full 64-bit product of two 32-bit values as a hi / lo pair */
+static void _mulWide( uint32_t a, uint32_t b, uint32_t *hi, uint32_t *lo )
+{
+    uint32_t ll = ( a & 0xFFFF ) * ( b & 0xFFFF );
+    uint32_t lh = ( a & 0xFFFF ) * ( b >> 16 );
+    uint32_t hl = ( a >> 16 ) * ( b & 0xFFFF );
+    uint32_t mid;
+
+    mid = ( ll >> 16 ) + ( lh & 0xFFFF ) + ( hl & 0xFFFF );
+    *lo = ( mid << 16 ) | ( ll & 0xFFFF );
+    *hi = ( a >> 16 ) * ( b >> 16 ) + ( lh >> 16 ) + ( hl >> 16 ) + ( mid >> 16 );
+}
+
+/* Pushes value to monotonic deque and drops entries older than size samples */
+static void _dequePush( T_MANOMETER_DEQUE *q, uint16_t size, uint16_t seq, uint16_t value, uint8_t isMax )
+{
+    T_MANOMETER_DEQUE_ITEM *back;
+    uint16_t pos;
+
+    while ( q->count > 0 )
+    {
+        pos = q->head + q->count - 1;
+        if ( pos >= size )
+            pos -= size;
+        back = &q->items[ pos ];
+        if ( isMax ? ( back->value > value ) : ( back->value < value ) )
+            break;
+        q->count--;
+    }
+
+    if ( ( q->count > 0 ) && ( ( uint16_t )( seq - q->items[ q->head ].seq ) >= size ) )
+    {
+        if ( ++q->head >= size )
+            q->head = 0;
+        q->count--;
+    }
+
+    pos = q->head + q->count;
+    if ( pos >= size )
+        pos -= size;
+    q->items[ pos ].seq = seq;
+    q->items[ pos ].value = value;
+    q->count++;
+}
+
+/* Cosine by Taylor series on [ -pi, pi ], avoids math library dependency */
+static float _cos( float angle )
+{
+    float x2;
+    float term = 1.0;
+    float result = 1.0;
+    uint8_t cnt;
+
+    while ( angle > 3.14159265 )
+        angle -= 6.28318531;
+    while ( angle < -3.14159265 )
+        angle += 6.28318531;
+
+    x2 = angle * angle;
+    for ( cnt = 1; cnt <= 7; cnt++ )
+    {
+        term = -term * x2 / ( float ) ( ( 2 * cnt - 1 ) * ( 2 * cnt ) );
+        result += term;
+    }
+
+    return result;
+}
+
+/* Q14 coefficient times 32-bit value without 64-bit intermediate, |value| < 2^30 */
+static int32_t _mulQ14( int32_t coeff, int32_t value )
+{
+    return coeff * ( value >> 14 ) + ( ( coeff * ( value & 0x3FFF ) ) >> 14 );
+}
+#endif
+
+#ifdef   __MANOMETER_LUT__
+/* Linear interpolation between table entries spaced 2^shift counts */
+static int32_t _lutInterpolate( const int32_t *table, uint16_t count, uint8_t shift )
+{
+    uint16_t pos = count >> shift;
+    int32_t frac = count & ( ( 1 << shift ) - 1 );
+    int32_t base = table[ pos ];
+    int32_t step = table[ pos + 1 ] - base;
+
+    if ( step < 0 )
+        return base - ( -step * frac + ( 1 << ( shift - 1 ) ) ) / ( 1 << shift );
+
+    return base + ( step * frac + ( 1 << ( shift - 1 ) ) ) / ( 1 << shift );
+}
+#endif
+
+/* Rounded ( a * b ) >> shift without 64-bit intermediate, |a| < 2^( 31 - shift ), |b| < 2^30 */
+static int32_t _mulShift( int32_t a, int32_t b, uint8_t shift )
+{
+    int32_t low = b & ( ( ( int32_t ) 1 << shift ) - 1 );
+
+    return a * ( b >> shift ) + ( ( a * low + ( ( int32_t ) 1 << ( shift - 1 ) ) ) >> shift );
+}
+
+/* Quadratic in Q15 x by Horner scheme, result in coefficient format */
+static int32_t _compPoly( int32_t *coeff, int32_t x )
+{
+    int32_t acc;
+
+    acc = _mulShift( x, coeff[ 2 ], 15 );
+    acc = _mulShift( x, coeff[ 1 ] + acc, 15 );
+
+    return coeff[ 0 ] + acc;
+}
 
 /* --------------------------------------------------------- PUBLIC FUNCTIONS */
 
@@ -71,8 +440,7 @@ void manometer_spiDriverInit(T_MANOMETER_P gpioObj, T_MANOMETER_P spiObj)
     hal_spiMap( (T_HAL_P)spiObj );
     hal_gpioMap( (T_HAL_P)gpioObj );
 
-    // ... power ON
-    // ... configure CHIP
+    hal_gpio_csSet( 1 );
 }
 
 #endif
@@ -81,6 +449,8 @@ void manometer_spiDriverInit(T_MANOMETER_P gpioObj, T_MANOMETER_P spiObj)
 void manometer_i2cDriverInit(T_MANOMETER_P gpioObj, T_MANOMETER_P i2cObj, uint8_t slave)
 {
     _slaveAddress = slave;
+    _sensor = 0;
+    _tempCycle = 0;
     hal_i2cMap( (T_HAL_P)i2cObj );
     hal_gpioMap( (T_HAL_P)gpioObj );
 
@@ -103,6 +473,197 @@ void manometer_uartDriverInit(T_MANOMETER_P gpioObj, T_MANOMETER_P uartObj)
 #endif
 
 
+#if defined( __MANOMETER_DRV_I2C__ ) || defined( __MANOMETER_TRACE__ )
+/* Reads application time source */
+static uint32_t _timeNow()
+{
+    if ( _timeFp == 0 )
+        return 0;
+
+    return _timeFp();
+}
+#endif
+
+#ifdef   __MANOMETER_TRACE__
+/* Records bus event into active trace */
+static void _traceEvent( uint8_t kind, uint8_t address, uint16_t nBytes, int16_t result )
+{
+    T_MANOMETER_TRACE_EVENT *event;
+
+    _traceLast = 0;
+    if ( _trace == 0 )
+        return;
+
+    event = &_trace->buffer[ _trace->head ];
+    event->time = _timeNow();
+    event->kind = kind;
+    event->address = address;
+    event->nBytes = nBytes;
+    event->result = result;
+
+    if ( ++_trace->head >= _trace->size )
+        _trace->head = 0;
+    if ( _trace->count < _trace->size )
+        _trace->count++;
+    else
+        _trace->lost++;
+    _traceLast = event;
+}
+
+/* Stores HAL result in the event recorded before the call, passes it through */
+static int _traceResult( int result )
+{
+    if ( _traceLast != 0 )
+        _traceLast->result = ( int16_t ) result;
+
+    return result;
+}
+#endif
+
+#ifdef   __MANOMETER_DRV_I2C__
+
+/* Runs one transfer: write, then read after a repeated start */
+static uint8_t _xferRun( T_MANOMETER_XFER *xfer )
+{
+    uint8_t endMode = ( xfer->nRead != 0 ) ? END_MODE_RESTART : END_MODE_STOP;
+    uint8_t err = _MANOMETER_OK;
+
+    if ( _TRACE_CALL( _MANOMETER_TRACE_START, xfer->slaveAddress, 0, hal_i2cStart() ) != 0 )
+        err = _MANOMETER_ERR_BUS;
+    else if ( ( xfer->nWrite != 0 ) &&
+              ( _TRACE_CALL( _MANOMETER_TRACE_WRITE, xfer->slaveAddress, xfer->nWrite,
+                             hal_i2cWrite( xfer->slaveAddress, xfer->writeBuf, xfer->nWrite, endMode ) ) != 0 ) )
+        err = _MANOMETER_ERR_BUS;
+    else if ( ( xfer->nRead != 0 ) &&
+              ( _TRACE_CALL( _MANOMETER_TRACE_READ, xfer->slaveAddress, xfer->nRead,
+                             hal_i2cRead( xfer->slaveAddress, xfer->readBuf, xfer->nRead, END_MODE_STOP ) ) != 0 ) )
+        err = _MANOMETER_ERR_BUS;
+    _TRACE( _MANOMETER_TRACE_STOP, xfer->slaveAddress, 0, err );
+
+    return err;
+}
+
+/* Issues transfer through the bus queue, or directly under the arbiter lock */
+static uint8_t _transfer( uint8_t slaveAddress, uint8_t *writeBuf, uint16_t nWrite, uint8_t *readBuf, uint16_t nRead )
+{
+    T_MANOMETER_XFER xfer;
+    uint8_t err;
+
+    xfer.slaveAddress = slaveAddress;
+    xfer.writeBuf = writeBuf;
+    xfer.nWrite = nWrite;
+    xfer.readBuf = readBuf;
+    xfer.nRead = nRead;
+    xfer.priority = _busPriority;
+    xfer.busSpeed = _busSpeedSelected;
+
+    if ( _queue != 0 )
+    {
+        err = manometer_queueSubmit( _queue, &xfer );
+        if ( err != _MANOMETER_OK )
+            return err;
+
+        // More urgent transfers of other drivers are served first
+        while ( xfer.status == _MANOMETER_XFER_PENDING )
+        {
+            if ( _queueServe( _queue, &xfer ) == 0 )
+            {
+                _queueRemove( _queue, &xfer );
+                return _MANOMETER_ERR_BUSY;
+            }
+        }
+
+        return xfer.status;
+    }
+
+    if ( _busLock() != _MANOMETER_OK )
+        return _MANOMETER_ERR_BUSY;
+
+    err = _xferRun( &xfer );
+
+    _busUnlock();
+
+    return err;
+}
+
+/* Takes transfer out of the queue without serving it */
+static void _queueRemove( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER *xfer )
+{
+    uint8_t pos;
+
+    for ( pos = 0; pos < queue->count; pos++ )
+    {
+        if ( queue->slots[ pos ] == xfer )
+            break;
+    }
+    if ( pos == queue->count )
+        return;
+
+    queue->count--;
+    for ( ; pos < queue->count; pos++ )
+        queue->slots[ pos ] = queue->slots[ pos + 1 ];
+}
+
+/* Serves one batch of pending transfers, ending early once last is served */
+static uint8_t _queueServe( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER *last )
+{
+    T_MANOMETER_XFER *xfer;
+    uint8_t served = 0;
+
+    if ( queue->count == 0 )
+        return 0;
+    if ( _busLock() != _MANOMETER_OK )
+        return 0;
+
+    // Every transfer runs at its own device clock, not at the one of this sensor
+    while ( ( queue->count != 0 ) && ( served < queue->batchMax ) )
+    {
+        xfer = queue->slots[ --queue->count ];
+        _busSetSpeed( ( xfer->busSpeed != 0 ) ? xfer->busSpeed : _MANOMETER_I2C_SPEED_STANDARD );
+        xfer->status = _xferRun( xfer );
+        served++;
+        if ( xfer == last )
+            break;
+    }
+    if ( _busSpeedSelected != 0 )
+        _busSetSpeed( _busSpeedSelected );
+
+    _busUnlock();
+
+    return served;
+}
+
+/* Checks that selected sensor returns valid frames at current clock */
+static uint8_t _verifySpeed()
+{
+    T_MANOMETER_SAMPLE sample;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < _MANOMETER_SPEED_VERIFY_READS; cnt++ )
+    {
+        if ( manometer_readSample( &sample ) != _MANOMETER_OK )
+            return _MANOMETER_ERR_BUS;
+        if ( sample.status == _MANOMETER_STATUS_DIAGNOSTIC )
+            return _MANOMETER_ERR_BUS;
+    }
+
+    return _MANOMETER_OK;
+}
+
+/* Writes multiplexer control register */
+static uint8_t _muxWrite( uint8_t muxAddress, uint8_t control )
+{
+    return _transfer( muxAddress, &control, 1, 0, 0 );
+}
+
+/* Sort key grouping sensors by multiplexer and channel */
+static uint16_t _muxKey( T_MANOMETER_SENSOR *sensor )
+{
+    return ( ( uint16_t ) sensor->muxAddress << 8 ) | sensor->muxChannel;
+}
+
+#endif
+
 /* ----------------------------------------------------------- IMPLEMENTATION */
 
 /* Generic write data function */
@@ -115,22 +676,49 @@ void manometer_writeData( uint8_t regAddress, uint32_t writeCommand )
     buffer[ 3 ] = ( uint8_t ) ( ( writeCommand &  0x00FF0000 ) >> 16 );
     buffer[ 4 ] = ( uint8_t ) ( ( writeCommand &  0xFF000000 ) >> 24 );
 
-    hal_i2cStart();
-    hal_i2cWrite( _slaveAddress, buffer, 5, END_MODE_STOP );
+#ifdef   __MANOMETER_DRV_SPI__
+    if ( _busLock() != _MANOMETER_OK )
+        return;
+
+    _TRACE( _MANOMETER_TRACE_START, 0, 0, 0 );
+    hal_gpio_csSet( 0 );
+    _TRACE( _MANOMETER_TRACE_WRITE, 0, 5, 0 );
+    hal_spiWrite( buffer, 5 );
+    hal_gpio_csSet( 1 );
+    _TRACE( _MANOMETER_TRACE_STOP, 0, 0, _MANOMETER_OK );
+
+    _busUnlock();
+#else
+    _transfer( _slaveAddress, buffer, 5, 0, 0 );
+#endif
 }
 
 /* Generic read data function */
 uint32_t manometer_readData( uint8_t regAddress )
 {
+#ifndef  __MANOMETER_DRV_SPI__
     uint8_t writeReg[ 1 ];
+#endif
     uint8_t readReg[ 4 ];
     uint32_t result;
-        
-    writeReg[ 0 ] = regAddress;
 
-    hal_i2cStart();
-    hal_i2cWrite( _slaveAddress, writeReg, 1, END_MODE_RESTART );
-    hal_i2cRead( _slaveAddress, readReg, 4, END_MODE_STOP );
+#ifdef   __MANOMETER_DRV_SPI__
+    if ( _busLock() != _MANOMETER_OK )
+        return 0;
+
+    _TRACE( _MANOMETER_TRACE_START, 0, 0, 0 );
+    hal_gpio_csSet( 0 );
+    _TRACE( _MANOMETER_TRACE_READ, 0, 4, 0 );
+    hal_spiRead( readReg, 4 );
+    hal_gpio_csSet( 1 );
+    _TRACE( _MANOMETER_TRACE_STOP, 0, 0, _MANOMETER_OK );
+
+    _busUnlock();
+#else
+    writeReg[ 0 ] = regAddress;
+    if ( _transfer( _slaveAddress, writeReg, 1, readReg, 4 ) != _MANOMETER_OK )
+        return 0;
+#endif
     
     result = readReg[ 0 ];
     result <<= 8;
@@ -143,26 +731,22 @@ uint32_t manometer_readData( uint8_t regAddress )
     return result;
 }
 
+#ifndef  __MANOMETER_MINIMAL__
 /* Function read pressure data */
 float manometer_getPressure()
 {
-    uint8_t writeReg[ 1 ];
     uint8_t readReg[ 4 ];
     uint16_t result = 0x0000;
     float pressure;
 
-    writeReg[ 0 ] = _MANOMETER_OUTPUT_ADDRESS;
-
-    hal_i2cStart();
-    hal_i2cWrite( _slaveAddress, writeReg, 1, END_MODE_RESTART );
-    hal_i2cRead( _slaveAddress, readReg, 4, END_MODE_STOP );
+    if ( _readFrame( readReg, 4 ) != _MANOMETER_OK )
+        return _MANOMETER_PRESSURE_ERROR;
 
-    result = readReg[ 0 ];
+    result = readReg[ 0 ] & 0x3F;
     result <<= 8;
     result |= readReg[ 1 ];
 
-    pressure = ( float ) result;
-    pressure = ( pressure - 1638.00 ) * ( ( 4.177 / 13107.00 ) * 1000.00 );
+    pressure = manometer_countToPressure( result );
     
     return pressure;
 }
@@ -170,29 +754,1079 @@ float manometer_getPressure()
 /* Function read temperature data */
 float manometer_getTemperature()
 {
-    uint8_t writeReg[ 1 ];
-    uint8_t readReg[ 4 ];
     uint16_t result = 0x0000;
     float temperature;
-        
-    writeReg[ 0 ] = _MANOMETER_OUTPUT_ADDRESS;
 
-    hal_i2cStart();
-    hal_i2cWrite( _slaveAddress, writeReg, 1, END_MODE_RESTART );
-    hal_i2cRead( _slaveAddress, readReg, 4, END_MODE_STOP );
+    if ( manometer_getTemperatureRaw( &result ) != _MANOMETER_OK )
+        return _MANOMETER_TEMPERATURE_ERROR;
+    temperature = manometer_countToTemperature( result );
+
+    return temperature;
+}
+
+/* Function converts raw pressure count to mbar */
+float manometer_countToPressure( uint16_t count )
+{
+    // Bits above the 14-bit count are ignored in every profile
+    count &= 0x3FFF;
+#ifdef   __MANOMETER_LUT__
+    return ( float ) _lutInterpolate( _lutPressure, count, _LUT_PRESSURE_SHIFT ) * 0.01;
+#else
+    return _countToPressure( ( float ) count );
+#endif
+}
+
+/* Function converts raw temperature count to degrees Celsius */
+float manometer_countToTemperature( uint16_t count )
+{
+    // Bits above the 11-bit count are ignored in every profile
+    count &= 0x07FF;
+#ifdef   __MANOMETER_LUT__
+    return ( float ) _lutInterpolate( _lutTemperature, count, _LUT_TEMPERATURE_SHIFT ) * 0.01;
+#else
+    return ( float ) count * ( 200.00 / 2047.00 ) - 50.00;
+#endif
+}
+#endif
+
+/* Function converts raw pressure count to Pa */
+int32_t manometer_countToPascal( uint16_t count )
+{
+#ifdef   __MANOMETER_LUT__
+    return _lutInterpolate( _lutPressure, count & 0x3FFF, _LUT_PRESSURE_SHIFT );
+#else
+    int32_t delta = ( int32_t ) ( count & 0x3FFF ) - 1638;
+    int32_t frac;
+
+    // 417700 Pa span over 13107 counts = 31 + 11383 / 13107 Pa per count
+    frac = delta * 11383;
+    if ( frac < 0 )
+        frac -= 6553;
+    else
+        frac += 6553;
 
-    result = readReg[ 2 ] ;
+    return delta * 31 + frac / 13107;
+#endif
+}
+
+/* Function read pressure data in Pa */
+int32_t manometer_getPressurePa()
+{
+    uint8_t readReg[ 2 ];
+    uint16_t result;
+
+    if ( _readFrame( readReg, 2 ) != _MANOMETER_OK )
+        return _MANOMETER_PRESSURE_PA_ERROR;
+
+    result = readReg[ 0 ] & 0x3F;
+    result <<= 8;
+    result |= readReg[ 1 ];
+
+    return manometer_countToPascal( result );
+}
+
+/* Function read raw 11-bit temperature count */
+uint8_t manometer_getTemperatureRaw( uint16_t *count )
+{
+    uint8_t readReg[ 4 ];
+    uint16_t result;
+    uint8_t err;
+
+    err = _readFrame( readReg, 4 );
+    if ( err != _MANOMETER_OK )
+        return err;
+
+    result = readReg[ 2 ];
     result <<= 8;
     result |= readReg[ 3 ];
-    result >>= 5;
-    result = result & 0x03E0;
-     
-    temperature = ( float ) result * 200.00;
-    temperature = ( temperature / 2047.00 ) - 50.00;
+    *count = result >> 5;
 
-    return temperature;
+    return _MANOMETER_OK;
 }
 
+/* Function converts raw temperature count to 0.01 degC */
+int16_t manometer_countToCentiCelsius( uint16_t count )
+{
+#ifdef   __MANOMETER_LUT__
+    return ( int16_t ) _lutInterpolate( _lutTemperature, count & 0x07FF, _LUT_TEMPERATURE_SHIFT );
+#else
+    int32_t scaled;
+
+    // T = count * 200 / 2047 - 50, rounded to 0.01 degC
+    scaled = ( ( int32_t ) ( count & 0x07FF ) * 20000 + 1023 ) / 2047;
+
+    return ( int16_t ) ( scaled - 5000 );
+#endif
+}
+
+/* Function read temperature data in 0.01 degC */
+int16_t manometer_getTemperatureCenti()
+{
+    uint16_t result = 0x0000;
+
+    if ( manometer_getTemperatureRaw( &result ) != _MANOMETER_OK )
+        return _MANOMETER_TEMPERATURE_CENTI_ERROR;
+
+    return manometer_countToCentiCelsius( result );
+}
+
+/* Function read one raw sample */
+uint8_t manometer_readSample( T_MANOMETER_SAMPLE *sample )
+{
+    uint8_t readReg[ 4 ];
+    uint8_t err;
+
+    err = _readFrame( readReg, 4 );
+    if ( err != _MANOMETER_OK )
+        return err;
+
+    _decodeSample( readReg, sample );
+    _lastTemperature = sample->temperature;
+
+    return _MANOMETER_OK;
+}
+
+/* Multi-rate temperature refresh setup */
+void manometer_setTemperatureDecimation( uint8_t decimation )
+{
+    _tempDecimation = ( decimation == 0 ) ? 1 : decimation;
+    _tempCycle = 0;
+}
+
+/* Function read one multi-rate sample */
+uint8_t manometer_readSampleMultiRate( T_MANOMETER_SAMPLE *sample )
+{
+    uint8_t readReg[ 4 ];
+    uint8_t err;
+
+    if ( _tempCycle == 0 )
+    {
+        err = manometer_readSample( sample );
+        if ( err != _MANOMETER_OK )
+            return err;
+    }
+    else
+    {
+        err = _readFrame( readReg, 2 );
+        if ( err != _MANOMETER_OK )
+            return err;
+
+        readReg[ 2 ] = 0;
+        readReg[ 3 ] = 0;
+        _decodeSample( readReg, sample );
+        sample->temperature = _lastTemperature;
+    }
+
+    if ( ++_tempCycle >= _tempDecimation )
+        _tempCycle = 0;
+
+    return _MANOMETER_OK;
+}
+
+/* Last-known temperature */
+uint16_t manometer_getLastTemperature()
+{
+    return _lastTemperature;
+}
+
+/* Shared bus arbiter setup */
+void manometer_setBusArbiter( T_MANOMETER_BUS_LOCK_FP lock, T_MANOMETER_BUS_UNLOCK_FP unlock, uint8_t priority )
+{
+    _busLockFp = lock;
+    _busUnlockFp = unlock;
+    _busPriority = priority;
+}
+
+/* Time source setup */
+void manometer_setTimeSource( T_MANOMETER_TIME_FP timeFp )
+{
+    _timeFp = timeFp;
+}
+
+#ifdef   __MANOMETER_DRV_I2C__
+
+/* Bus clock handler setup */
+void manometer_setBusSpeedHandler( T_MANOMETER_BUS_SPEED_FP handler )
+{
+    _busSpeedHandler = handler;
+    _busSpeed = 0;
+}
+
+/* Sensor instance initialization */
+void manometer_sensorInit( T_MANOMETER_SENSOR *sensor, uint8_t slave )
+{
+    sensor->slaveAddress = slave;
+    sensor->busSpeed = _MANOMETER_I2C_SPEED_STANDARD;
+    sensor->muxAddress = 0;
+    sensor->muxChannel = 0;
+    sensor->tempCycle = 0;
+    sensor->lastTemperature = 0;
+}
+
+/* Sensor instance multiplexer setup */
+void manometer_sensorSetMux( T_MANOMETER_SENSOR *sensor, uint8_t muxAddress, uint8_t muxChannel )
+{
+    sensor->muxAddress = muxAddress;
+    sensor->muxChannel = muxChannel & 0x07;
+}
+
+/* Sensor instance selection */
+uint8_t manometer_selectSensor( T_MANOMETER_SENSOR *sensor )
+{
+    uint8_t err;
+
+    // Multi-rate temperature cache follows the selected sensor
+    if ( sensor != _sensor )
+    {
+        if ( _sensor != 0 )
+        {
+            _sensor->tempCycle = _tempCycle;
+            _sensor->lastTemperature = _lastTemperature;
+        }
+        _tempCycle = sensor->tempCycle;
+        _lastTemperature = sensor->lastTemperature;
+        _sensor = sensor;
+    }
+
+    _slaveAddress = sensor->slaveAddress;
+    _busSpeedSelected = sensor->busSpeed;
+
+    // Direct sensor: the active channel is turned off so no muxed device answers as well
+    if ( sensor->muxAddress == 0 )
+    {
+        if ( _muxAddress == 0 )
+            return _MANOMETER_OK;
+        err = _muxWrite( _muxAddress, 0x00 );
+        manometer_invalidateMux();
+        return err;
+    }
+    if ( ( sensor->muxAddress == _muxAddress ) && ( sensor->muxChannel == _muxChannel ) )
+        return _MANOMETER_OK;
+
+    if ( ( _muxAddress != 0 ) && ( _muxAddress != sensor->muxAddress ) )
+    {
+        err = _muxWrite( _muxAddress, 0x00 );
+        if ( err != _MANOMETER_OK )
+        {
+            manometer_invalidateMux();
+            return err;
+        }
+    }
+
+    err = _muxWrite( sensor->muxAddress, 1 << sensor->muxChannel );
+    if ( err != _MANOMETER_OK )
+    {
+        manometer_invalidateMux();
+        return err;
+    }
+
+    _muxAddress = sensor->muxAddress;
+    _muxChannel = sensor->muxChannel;
+
+    return _MANOMETER_OK;
+}
+
+/* Multiplexer cache invalidation */
+void manometer_invalidateMux()
+{
+    _muxAddress = 0;
+    _muxChannel = 0xFF;
+}
+
+/* Sensor list ordering for multiplexer scans */
+void manometer_sortSensors( T_MANOMETER_SENSOR **list, uint8_t n )
+{
+    T_MANOMETER_SENSOR *tmp;
+    uint8_t i;
+    uint8_t j;
+
+    for ( i = 1; i < n; i++ )
+    {
+        tmp = list[ i ];
+        for ( j = i; ( j > 0 ) && ( _muxKey( list[ j - 1 ] ) > _muxKey( tmp ) ); j-- )
+            list[ j ] = list[ j - 1 ];
+        list[ j ] = tmp;
+    }
+}
+
+/* Bus clock negotiation */
+uint8_t manometer_negotiateSpeed( T_MANOMETER_SENSOR *sensor )
+{
+    uint8_t err;
+
+    sensor->busSpeed = _MANOMETER_I2C_SPEED_FAST;
+    err = manometer_selectSensor( sensor );
+    if ( err != _MANOMETER_OK )
+        return err;
+    if ( _verifySpeed() == _MANOMETER_OK )
+        return _MANOMETER_OK;
+
+    sensor->busSpeed = _MANOMETER_I2C_SPEED_STANDARD;
+    err = manometer_selectSensor( sensor );
+    if ( err != _MANOMETER_OK )
+        return err;
+
+    return _verifySpeed();
+}
+
+/* Synchronized group initialization */
+void manometer_groupInit( T_MANOMETER_GROUP *group, T_MANOMETER_SENSOR **sensors, T_MANOMETER_SAMPLE *samples,
+                          uint32_t *offsets, uint8_t n, uint8_t withTemperature )
+{
+    group->sensors = sensors;
+    group->samples = samples;
+    group->offsets = offsets;
+    group->n = n;
+    group->withTemperature = withTemperature;
+    group->timestamp = 0;
+    group->skew = 0;
+}
+
+/* Synchronized group read */
+uint8_t manometer_groupRead( T_MANOMETER_GROUP *group )
+{
+    T_MANOMETER_SAMPLE *sample;
+    uint8_t readReg[ 4 ];
+    uint32_t before;
+    uint32_t after;
+    uint8_t err;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < group->n; cnt++ )
+    {
+        err = manometer_selectSensor( group->sensors[ cnt ] );
+        if ( err != _MANOMETER_OK )
+            return err;
+
+        sample = &group->samples[ cnt ];
+        before = _timeNow();
+        err = _readFrame( readReg, group->withTemperature ? 4 : 2 );
+        after = _timeNow();
+        if ( err != _MANOMETER_OK )
+            return err;
+
+        // Previous sample is kept when the read fails
+        if ( group->withTemperature )
+            _decodeSample( readReg, sample );
+        else
+        {
+            sample->status = readReg[ 0 ] >> 6;
+            sample->pressure = ( ( uint16_t ) ( readReg[ 0 ] & 0x3F ) << 8 ) | readReg[ 1 ];
+        }
+
+        before += ( after - before ) / 2;
+        if ( cnt == 0 )
+            group->timestamp = before;
+        group->offsets[ cnt ] = before - group->timestamp;
+    }
+    group->skew = ( group->n > 0 ) ? group->offsets[ group->n - 1 ] : 0;
+
+    return _MANOMETER_OK;
+}
+
+/* Pressure differential of two group members */
+int16_t manometer_groupGetDifferential( T_MANOMETER_GROUP *group, uint8_t a, uint8_t b )
+{
+    return ( int16_t ) group->samples[ a ].pressure - ( int16_t ) group->samples[ b ].pressure;
+}
+
+/* Time skew of the last group read */
+uint32_t manometer_groupGetSkew( T_MANOMETER_GROUP *group )
+{
+    return group->skew;
+}
+
+/* Bus queue initialization */
+void manometer_queueInit( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER **slots, uint8_t size, uint8_t batchMax )
+{
+    queue->slots = slots;
+    queue->size = size;
+    queue->count = 0;
+    queue->batchMax = ( batchMax != 0 ) ? batchMax : 1;
+}
+
+/* Bus queue transfer submission */
+uint8_t manometer_queueSubmit( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER *xfer )
+{
+    uint8_t pos;
+
+    if ( queue->count >= queue->size )
+        return _MANOMETER_ERR_BUSY;
+
+    // Slots are kept in ascending priority, next transfer is the last one;
+    // a new transfer goes below every pending one of the same priority
+    pos = queue->count;
+    while ( ( pos > 0 ) && ( queue->slots[ pos - 1 ]->priority >= xfer->priority ) )
+    {
+        queue->slots[ pos ] = queue->slots[ pos - 1 ];
+        pos--;
+    }
+    queue->slots[ pos ] = xfer;
+    queue->count++;
+    xfer->status = _MANOMETER_XFER_PENDING;
+
+    return _MANOMETER_OK;
+}
+
+/* Bus queue service step */
+uint8_t manometer_queueService( T_MANOMETER_QUEUE *queue )
+{
+    return _queueServe( queue, 0 );
+}
+
+/* Bus queue pending transfer count */
+uint8_t manometer_queueGetCount( T_MANOMETER_QUEUE *queue )
+{
+    return queue->count;
+}
+
+/* Driver bus queue setup */
+void manometer_setBusQueue( T_MANOMETER_QUEUE *queue )
+{
+    _queue = queue;
+}
+
+#endif
+
+/* Burst capture initialization */
+void manometer_burstInit( T_MANOMETER_BURST *burst, uint16_t *buffer, uint16_t size, uint16_t preTrigger )
+{
+    burst->buffer = buffer;
+    burst->size = size;
+    burst->preTrigger = ( preTrigger < size ) ? preTrigger : size - 1;
+    burst->triggerMode = _MANOMETER_TRIGGER_RISING;
+    burst->level = 0x3FFF;
+
+    manometer_burstArm( burst );
+}
+
+/* Burst trigger setup */
+void manometer_burstSetTrigger( T_MANOMETER_BURST *burst, uint8_t mode, int16_t level )
+{
+    burst->triggerMode = mode;
+    burst->level = level;
+}
+
+/* Burst re-arm */
+void manometer_burstArm( T_MANOMETER_BURST *burst )
+{
+    burst->head = 0;
+    burst->count = 0;
+    burst->postCount = 0;
+    burst->lastPressure = 0;
+    burst->state = _MANOMETER_BURST_ARMED;
+}
+
+/* Burst acquisition step */
+uint8_t manometer_burstTask( T_MANOMETER_BURST *burst )
+{
+    T_MANOMETER_SAMPLE sample;
+
+    if ( burst->state == _MANOMETER_BURST_DONE )
+        return burst->state;
+
+    if ( manometer_readSample( &sample ) != _MANOMETER_OK )
+        return burst->state;
+
+    if ( sample.status != _MANOMETER_STATUS_NORMAL )
+        return burst->state;
+
+    if ( burst->state == _MANOMETER_BURST_ARMED )
+    {
+        if ( _burstIsTrigger( burst, sample.pressure ) )
+            burst->state = _MANOMETER_BURST_TRIGGERED;
+    }
+
+    burst->buffer[ burst->head ] = sample.pressure;
+    if ( ++burst->head >= burst->size )
+        burst->head = 0;
+    if ( burst->count < burst->size )
+        burst->count++;
+    burst->lastPressure = sample.pressure;
+
+    if ( burst->state == _MANOMETER_BURST_TRIGGERED )
+    {
+        if ( ++burst->postCount >= burst->size - burst->preTrigger )
+            burst->state = _MANOMETER_BURST_DONE;
+    }
+
+    return burst->state;
+}
+
+/* Burst captured sample count */
+uint16_t manometer_burstGetCount( T_MANOMETER_BURST *burst )
+{
+    return burst->count;
+}
+
+/* Burst trigger position */
+uint16_t manometer_burstGetTriggerIndex( T_MANOMETER_BURST *burst )
+{
+    return burst->count - burst->postCount;
+}
+
+/* Burst captured sample */
+uint16_t manometer_burstGetSample( T_MANOMETER_BURST *burst, uint16_t index )
+{
+    uint16_t pos;
+
+    pos = burst->head + burst->size - burst->count + index;
+    if ( pos >= burst->size )
+        pos -= burst->size;
+    if ( pos >= burst->size )
+        pos -= burst->size;
+
+    return burst->buffer[ pos ];
+}
+
+#ifndef  __MANOMETER_MINIMAL__
+/* Streaming statistics initialization */
+void manometer_statsInit( T_MANOMETER_STATS *stats, uint16_t window, T_MANOMETER_DEQUE_ITEM *minBuf, T_MANOMETER_DEQUE_ITEM *maxBuf )
+{
+    stats->minQ.items = minBuf;
+    stats->minQ.head = 0;
+    stats->minQ.count = 0;
+    stats->maxQ.items = maxBuf;
+    stats->maxQ.head = 0;
+    stats->maxQ.count = 0;
+    stats->window = window;
+    stats->seq = 0;
+    stats->n = 0;
+    stats->ref = 0;
+    stats->sum = 0;
+    stats->sumSqLo = 0;
+    stats->sumSqHi = 0;
+}
+
+/* Streaming statistics update */
+uint8_t manometer_statsUpdate( T_MANOMETER_STATS *stats, uint16_t pressure )
+{
+    int32_t delta;
+    uint32_t square;
+
+    _dequePush( &stats->minQ, stats->window, stats->seq, pressure, 0 );
+    _dequePush( &stats->maxQ, stats->window, stats->seq, pressure, 1 );
+    stats->seq++;
+
+    if ( stats->n >= stats->window )
+        stats->n = 0;
+    if ( stats->n == 0 )
+    {
+        stats->ref = pressure;
+        stats->sum = 0;
+        stats->sumSqLo = 0;
+        stats->sumSqHi = 0;
+    }
+
+    // Offset from the window's first sample keeps the sums small, square fits 28 bits
+    stats->n++;
+    delta = ( int32_t ) pressure - ( int32_t ) stats->ref;
+    square = ( uint32_t ) ( delta * delta );
+    stats->sum += delta;
+    stats->sumSqLo += square;
+    if ( stats->sumSqLo < square )
+        stats->sumSqHi++;
+
+    return stats->n >= stats->window;
+}
+
+/* Closed window statistics */
+void manometer_statsGetWindow( T_MANOMETER_STATS *stats, T_MANOMETER_STATS_RESULT *result )
+{
+    float variance = 0.0;
+    float mean;
+    uint32_t nSqHi, nSqLo;
+    uint32_t sqHi, sqLo;
+    uint32_t magnitude;
+
+    mean = ( float ) stats->sum / ( float ) stats->n;
+    if ( stats->n > 1 )
+    {
+        // n * sumSq - sum^2 is exact and never negative, only the result goes to float
+        _mulWide( stats->sumSqLo, stats->n, &nSqHi, &nSqLo );
+        nSqHi += stats->sumSqHi * stats->n;
+        magnitude = ( stats->sum < 0 ) ? ( uint32_t ) -stats->sum : ( uint32_t ) stats->sum;
+        _mulWide( magnitude, magnitude, &sqHi, &sqLo );
+        nSqHi -= sqHi + ( nSqLo < sqLo );
+        nSqLo -= sqLo;
+
+        variance = ( ( float ) nSqHi * 4294967296.0 + ( float ) nSqLo ) /
+                   ( ( float ) stats->n * ( float ) ( stats->n - 1 ) );
+    }
+
+    result->mean = _countToPressure( ( float ) stats->ref + mean );
+    result->stddev = _sqrt( variance ) * ( ( 4.177 / 13107.00 ) * 1000.00 );
+    result->min = _countToPressure( ( float ) manometer_statsGetMin( stats ) );
+    result->max = _countToPressure( ( float ) manometer_statsGetMax( stats ) );
+}
+
+/* Sliding window minimum */
+uint16_t manometer_statsGetMin( T_MANOMETER_STATS *stats )
+{
+    return stats->minQ.items[ stats->minQ.head ].value;
+}
+
+/* Sliding window maximum */
+uint16_t manometer_statsGetMax( T_MANOMETER_STATS *stats )
+{
+    return stats->maxQ.items[ stats->maxQ.head ].value;
+}
+#endif
+
+/* Histogram initialization */
+void manometer_histInit( T_MANOMETER_HISTOGRAM *hist, uint32_t *bins, uint8_t shift )
+{
+    uint16_t cnt;
+
+    hist->bins = bins;
+    hist->shift = shift;
+    hist->nBins = 0x4000 >> shift;
+    hist->total = 0;
+
+    for ( cnt = 0; cnt < hist->nBins; cnt++ )
+        hist->bins[ cnt ] = 0;
+}
+
+/* Histogram update */
+void manometer_histAdd( T_MANOMETER_HISTOGRAM *hist, uint16_t pressure )
+{
+    hist->bins[ ( pressure & 0x3FFF ) >> hist->shift ]++;
+    hist->total++;
+}
+
+/* Histogram merge */
+uint8_t manometer_histMerge( T_MANOMETER_HISTOGRAM *dst, T_MANOMETER_HISTOGRAM *src )
+{
+    uint16_t cnt;
+
+    if ( dst->shift != src->shift )
+        return _MANOMETER_ERR_PARAM;
+
+    for ( cnt = 0; cnt < dst->nBins; cnt++ )
+        dst->bins[ cnt ] += src->bins[ cnt ];
+    dst->total += src->total;
+
+    return _MANOMETER_OK;
+}
+
+/* Histogram quantile */
+uint16_t manometer_histGetQuantile( T_MANOMETER_HISTOGRAM *hist, uint16_t permille )
+{
+    uint32_t rank;
+    uint32_t below = 0;
+    uint32_t bin;
+    uint32_t rem;
+    uint16_t offset = 0;
+    uint16_t cnt;
+    uint8_t half;
+    uint8_t bit;
+
+    if ( hist->total == 0 )
+        return 0;
+
+    rank = ( hist->total / 1000 ) * permille + ( ( hist->total % 1000 ) * permille ) / 1000;
+    if ( rank == 0 )
+        rank = 1;
+    if ( rank > hist->total )
+        rank = hist->total;
+
+    for ( cnt = 0; cnt < hist->nBins; cnt++ )
+    {
+        if ( below + hist->bins[ cnt ] >= rank )
+            break;
+        below += hist->bins[ cnt ];
+    }
+
+    // offset = ( rank - below - 1/2 ) * 2^shift / bin, rounded, by long division so no product can overflow
+    bin = hist->bins[ cnt ];
+    rem = rank - below - 1;
+    for ( bit = 0; bit < hist->shift; bit++ )
+    {
+        half = ( bit == 0 );
+        offset <<= 1;
+        if ( rem >= bin - rem - half )
+        {
+            rem -= bin - rem - half;
+            offset |= 1;
+        }
+        else
+            rem = 2 * rem + half;
+    }
+    if ( ( rem >= bin - rem ) && ( offset < ( ( 1 << hist->shift ) - 1 ) ) )
+        offset++;
+
+    return ( ( uint16_t ) cnt << hist->shift ) + offset;
+}
+
+#ifndef  __MANOMETER_MINIMAL__
+/* Ripple analysis initialization */
+void manometer_rippleInit( T_MANOMETER_RIPPLE *ripple, T_MANOMETER_TONE *tones, uint8_t nTones, uint16_t blockSize )
+{
+    uint8_t cnt;
+
+    ripple->tones = tones;
+    ripple->nTones = nTones;
+    ripple->blockSize = blockSize;
+    ripple->n = 0;
+    ripple->offset = 0xFFFF;
+    ripple->sum = 0;
+
+    for ( cnt = 0; cnt < nTones; cnt++ )
+    {
+        tones[ cnt ].coeff = 0;
+        tones[ cnt ].s1 = 0;
+        tones[ cnt ].s2 = 0;
+        tones[ cnt ].amplitude = 0.0;
+    }
+}
+
+/* Ripple band setup */
+void manometer_rippleSetBand( T_MANOMETER_RIPPLE *ripple, uint8_t band, float frequency, float sampleRate )
+{
+    ripple->tones[ band ].coeff = ( int32_t ) ( 2.0 * 16384.0 * _cos( 6.28318531 * frequency / sampleRate ) );
+}
+
+/* Ripple analysis update */
+uint8_t manometer_rippleUpdate( T_MANOMETER_RIPPLE *ripple, uint16_t pressure )
+{
+    T_MANOMETER_TONE *tone;
+    int32_t x;
+    int32_t s0;
+    float s1;
+    float s2;
+    float power;
+    uint8_t cnt;
+
+    if ( ripple->offset == 0xFFFF )
+        ripple->offset = pressure;
+
+    x = ( int32_t ) pressure - ( int32_t ) ripple->offset;
+    ripple->sum += pressure;
+
+    for ( cnt = 0; cnt < ripple->nTones; cnt++ )
+    {
+        tone = &ripple->tones[ cnt ];
+        s0 = x + _mulQ14( tone->coeff, tone->s1 ) - tone->s2;
+        tone->s2 = tone->s1;
+        tone->s1 = s0;
+    }
+
+    if ( ++ripple->n < ripple->blockSize )
+        return 0;
+
+    for ( cnt = 0; cnt < ripple->nTones; cnt++ )
+    {
+        tone = &ripple->tones[ cnt ];
+        s1 = ( float ) tone->s1;
+        s2 = ( float ) tone->s2;
+        power = s1 * s1 + s2 * s2 - ( ( float ) tone->coeff / 16384.0 ) * s1 * s2;
+        tone->amplitude = 2.0 * _sqrt( power ) / ( float ) ripple->blockSize * ( ( 4.177 / 13107.00 ) * 1000.00 );
+        tone->s1 = 0;
+        tone->s2 = 0;
+    }
+
+    ripple->offset = ( uint16_t ) ( ripple->sum / ripple->blockSize );
+    ripple->sum = 0;
+    ripple->n = 0;
+
+    return 1;
+}
+
+/* Ripple band amplitude */
+float manometer_rippleGetAmplitude( T_MANOMETER_RIPPLE *ripple, uint8_t band )
+{
+    return ripple->tones[ band ].amplitude;
+}
+#endif
+
+/* Deadband reporter initialization */
+void manometer_deadbandInit( T_MANOMETER_DEADBAND *deadband, uint16_t threshold, uint32_t maxSilence )
+{
+    deadband->threshold = threshold;
+    deadband->maxSilence = maxSilence;
+    deadband->lastValue = 0;
+    deadband->lastTime = 0;
+    deadband->primed = 0;
+}
+
+/* Deadband reporter update */
+uint8_t manometer_deadbandUpdate( T_MANOMETER_DEADBAND *deadband, uint16_t pressure, uint32_t now )
+{
+    uint16_t diff;
+
+    if ( deadband->primed )
+    {
+        diff = ( pressure > deadband->lastValue ) ? pressure - deadband->lastValue : deadband->lastValue - pressure;
+
+        if ( ( diff <= deadband->threshold ) &&
+             ( ( deadband->maxSilence == 0 ) || ( ( uint32_t ) ( now - deadband->lastTime ) < deadband->maxSilence ) ) )
+            return 0;
+    }
+
+    deadband->primed = 1;
+    deadband->lastValue = pressure;
+    deadband->lastTime = now;
+
+    return 1;
+}
+
+/* Rate controller initialization */
+void manometer_rateInit( T_MANOMETER_RATE *rate, uint16_t slowPeriod, uint16_t fastPeriod, uint32_t enterRate, uint32_t exitRate )
+{
+    rate->slowPeriod = slowPeriod;
+    rate->fastPeriod = fastPeriod;
+    rate->enterRate = enterRate;
+    rate->exitRate = exitRate;
+    rate->activity = 0;
+    rate->period = slowPeriod;
+    rate->lastValue = 0;
+    rate->switches = 0;
+    rate->primed = 0;
+}
+
+/* Rate controller update */
+uint16_t manometer_rateUpdate( T_MANOMETER_RATE *rate, uint16_t pressure )
+{
+    int32_t slope;
+    uint32_t activity;
+
+    if ( !rate->primed )
+    {
+        rate->primed = 1;
+        rate->lastValue = pressure;
+        return rate->period;
+    }
+
+    slope = ( ( int32_t ) pressure - ( int32_t ) rate->lastValue ) * 1000 / ( int32_t ) rate->period;
+    rate->lastValue = pressure;
+    rate->activity += ( slope - rate->activity ) / 4;
+
+    activity = ( rate->activity < 0 ) ? ( uint32_t ) -rate->activity : ( uint32_t ) rate->activity;
+
+    if ( ( rate->period == rate->slowPeriod ) && ( activity >= rate->enterRate ) )
+    {
+        rate->period = rate->fastPeriod;
+        rate->switches++;
+    }
+    else if ( ( rate->period == rate->fastPeriod ) && ( activity < rate->exitRate ) )
+    {
+        rate->period = rate->slowPeriod;
+        rate->switches++;
+    }
+
+    return rate->period;
+}
+
+/* Current sample period */
+uint16_t manometer_rateGetPeriod( T_MANOMETER_RATE *rate )
+{
+    return rate->period;
+}
+
+/* Number of rate switches */
+uint16_t manometer_rateGetSwitches( T_MANOMETER_RATE *rate )
+{
+    return rate->switches;
+}
+
+/* Power-up readiness */
+uint8_t manometer_waitReady( uint16_t timeout, uint16_t *timeToReady )
+{
+    T_MANOMETER_SAMPLE sample;
+    uint16_t polls = 0;
+    uint32_t start = 0;
+    uint32_t elapsed;
+    uint8_t err = _MANOMETER_ERR_TIMEOUT;
+
+    if ( _timeFp != 0 )
+        start = _timeFp();
+
+    for ( ;; )
+    {
+        if ( ( manometer_readSample( &sample ) == _MANOMETER_OK ) &&
+             ( sample.status == _MANOMETER_STATUS_NORMAL ) )
+        {
+            err = _MANOMETER_OK;
+            break;
+        }
+        if ( polls >= timeout )
+            break;
+
+        Delay_1ms();
+        polls++;
+    }
+
+    // Measured time when a time source is set, otherwise count of 1 ms delays
+    *timeToReady = polls;
+    if ( _timeFp != 0 )
+    {
+        elapsed = _timeFp() - start;
+        *timeToReady = ( elapsed > 0xFFFF ) ? 0xFFFF : ( uint16_t ) elapsed;
+    }
+
+    return err;
+}
+
+/* Temperature compensation initialization */
+void manometer_compInit( T_MANOMETER_COMP *comp, uint16_t tRef, int32_t *offset, int32_t *gain )
+{
+    uint8_t cnt;
+
+    comp->tRef = tRef;
+    for ( cnt = 0; cnt < 3; cnt++ )
+    {
+        comp->offset[ cnt ] = offset[ cnt ];
+        comp->gain[ cnt ] = gain[ cnt ];
+    }
+}
+
+/* Temperature compensation of one sample */
+uint16_t manometer_compApply( T_MANOMETER_COMP *comp, T_MANOMETER_SAMPLE *sample )
+{
+    int32_t x;
+    int32_t offset;
+    int32_t gain;
+    int32_t pressure;
+
+    x = ( ( int32_t ) sample->temperature - ( int32_t ) comp->tRef ) * 16;
+    offset = _compPoly( comp->offset, x );
+    gain = _compPoly( comp->gain, x );
+
+    // correction in Q8 counts, offset is Q16 and gain Q24
+    pressure = sample->pressure;
+    pressure += ( _mulShift( 1, offset, 8 ) + _mulShift( pressure - 8192, gain, 16 ) + 0x80 ) >> 8;
+    if ( pressure < 0 )
+        pressure = 0;
+    if ( pressure > 0x3FFF )
+        pressure = 0x3FFF;
+    sample->pressure = ( uint16_t ) pressure;
+
+    return sample->pressure;
+}
+
+/* Pressure filter initialization */
+void manometer_kalmanInit( T_MANOMETER_KALMAN *kalman, uint16_t alpha, uint16_t beta )
+{
+    kalman->level = 0;
+    kalman->rate = 0;
+    kalman->alpha = alpha;
+    kalman->beta = beta;
+    kalman->lastTime = 0;
+    kalman->primed = 0;
+}
+
+#ifndef  __MANOMETER_MINIMAL__
+/* Pressure filter gains from noise parameters */
+void manometer_kalmanTune( T_MANOMETER_KALMAN *kalman, float accelNoise, float measNoise, uint16_t period )
+{
+    float dt = ( float ) period * 0.001;
+    float lambda;
+    float r;
+    float alpha;
+    float beta;
+
+    // Kalata tracking index and steady-state alpha-beta gains
+    lambda = accelNoise * dt * dt / measNoise;
+    r = ( 4.0 + lambda - _sqrt( 8.0 * lambda + lambda * lambda ) ) / 4.0;
+    alpha = 1.0 - r * r;
+    beta = 2.0 * ( 2.0 - alpha ) - 4.0 * _sqrt( 1.0 - alpha );
+
+    kalman->alpha = ( int32_t ) ( alpha * 32768.0 + 0.5 );
+    kalman->beta = ( int32_t ) ( beta * 32768.0 + 0.5 );
+}
+#endif
+
+/* Pressure filter update */
+uint16_t manometer_kalmanUpdate( T_MANOMETER_KALMAN *kalman, uint16_t pressure, uint32_t now )
+{
+    int32_t dt;
+    int32_t residual;
+    int32_t correction;
+
+    dt = ( int32_t ) ( now - kalman->lastTime );
+
+    // Time going backwards or a long gap leaves the rate unknown, restart from the measurement
+    if ( !kalman->primed || ( dt < 0 ) || ( dt > _MANOMETER_KALMAN_GAP_MAX ) )
+    {
+        kalman->level = ( int32_t ) pressure * 256;
+        kalman->rate = 0;
+        kalman->lastTime = now;
+        kalman->primed = 1;
+
+        return pressure;
+    }
+    kalman->lastTime = now;
+
+    kalman->level += _mulShift( dt, kalman->rate, 8 );
+    residual = ( int32_t ) pressure * 256 - kalman->level;
+    kalman->level += _mulShift( kalman->alpha, residual, 15 );
+    if ( dt > 0 )
+    {
+        correction = _mulShift( kalman->beta, residual, 15 );
+        kalman->rate += ( correction / dt ) * 256 + ( correction % dt ) * 256 / dt;
+    }
+
+    if ( kalman->level < 0 )
+        return 0;
+    if ( kalman->level > ( ( int32_t ) 0x3FFF << 8 ) )
+        return 0x3FFF;
+
+    return ( uint16_t ) ( ( kalman->level + 0x80 ) >> 8 );
+}
+
+/* Pressure filter rate */
+int32_t manometer_kalmanGetRate( T_MANOMETER_KALMAN *kalman )
+{
+    return _mulShift( 1000, kalman->rate, 16 );
+}
+
+#ifdef   __MANOMETER_TRACE__
+
+/* Trace start */
+void manometer_traceInit( T_MANOMETER_TRACE *trace, T_MANOMETER_TRACE_EVENT *buffer, uint16_t size )
+{
+    trace->buffer = buffer;
+    trace->size = size;
+    trace->head = 0;
+    trace->count = 0;
+    trace->lost = 0;
+
+    _trace = trace;
+}
+
+/* Trace stop */
+void manometer_traceStop()
+{
+    _trace = 0;
+}
+
+/* Trace recorded event count */
+uint16_t manometer_traceGetCount( T_MANOMETER_TRACE *trace )
+{
+    return trace->count;
+}
+
+/* Trace recorded event */
+T_MANOMETER_TRACE_EVENT *manometer_traceGetEvent( T_MANOMETER_TRACE *trace, uint16_t index )
+{
+    uint16_t pos;
+
+    pos = trace->head + trace->size - trace->count + index;
+    if ( pos >= trace->size )
+        pos -= trace->size;
+    if ( pos >= trace->size )
+        pos -= trace->size;
+
+    return &trace->buffer[ pos ];
+}
+
+/* Trace lost event count */
+uint32_t manometer_traceGetLost( T_MANOMETER_TRACE *trace )
+{
+    return trace->lost;
+}
+#endif
+
 
 
 /* -------------------------------------------------------------------------- */
@@ -47,13 +47,60 @@
 
 /** @defgroup MANOMETER_COMPILE Compilation Config */              /** @{ */
 
-//  #define   __MANOMETER_DRV_SPI__                            /**<     @macro __MANOMETER_DRV_SPI__  @brief SPI driver selector */
+//  #define   __MANOMETER_DRV_SPI__                            /**<     @macro __MANOMETER_DRV_SPI__  @brief SPI driver selector ( HSC SPI variants ) */
+#ifndef   __MANOMETER_DRV_SPI__
    #define   __MANOMETER_DRV_I2C__                            /**<     @macro __MANOMETER_DRV_I2C__  @brief I2C driver selector */                                          
+#endif
 // #define   __MANOMETER_DRV_UART__                           /**<     @macro __MANOMETER_DRV_UART__ @brief UART driver selector */ 
+// #define   __MANOMETER_MINIMAL__                            /**<     @macro __MANOMETER_MINIMAL__ @brief Minimal footprint profile ( integer API only ) */
+// #define   __MANOMETER_LUT__                                /**<     @macro __MANOMETER_LUT__ @brief Table conversion ( __manometer_lut.h ) */
+// #define   __MANOMETER_TRACE__                              /**<     @macro __MANOMETER_TRACE__ @brief Bus transaction tracer */
 
                                                                        /** @} */
 /** @defgroup MANOMETER_VAR Variables */                           /** @{ */
 
+#ifdef   __MANOMETER_MINIMAL__
+/* Minimal profile: codes as macros, no constant storage on the target */
+#define _MANOMETER_OUTPUT_ADDRESS           0x38
+
+#define _MANOMETER_I2C_ADDRESS              0x38
+
+#define _MANOMETER_STATUS_NORMAL            0x00
+#define _MANOMETER_STATUS_COMMAND           0x01
+#define _MANOMETER_STATUS_STALE             0x02
+#define _MANOMETER_STATUS_DIAGNOSTIC        0x03
+
+#define _MANOMETER_OK                       0x00
+#define _MANOMETER_ERR_BUS                  0x01
+#define _MANOMETER_ERR_BUSY                 0x02
+#define _MANOMETER_ERR_PARAM                0x03
+#define _MANOMETER_ERR_TIMEOUT              0x04
+
+#define _MANOMETER_PRESSURE_PA_ERROR        ( ( int32_t )-1000000 )
+#define _MANOMETER_TEMPERATURE_CENTI_ERROR  ( ( int16_t )-30000 )
+
+#define _MANOMETER_TRIGGER_RISING           0x00
+#define _MANOMETER_TRIGGER_FALLING          0x01
+#define _MANOMETER_TRIGGER_SLOPE            0x02
+
+#define _MANOMETER_BURST_ARMED              0x00
+#define _MANOMETER_BURST_TRIGGERED          0x01
+#define _MANOMETER_BURST_DONE               0x02
+
+#ifdef   __MANOMETER_TRACE__
+#define _MANOMETER_TRACE_START              0x00
+#define _MANOMETER_TRACE_WRITE              0x01
+#define _MANOMETER_TRACE_READ               0x02
+#define _MANOMETER_TRACE_STOP               0x03
+#endif
+
+#ifdef   __MANOMETER_DRV_I2C__
+#define _MANOMETER_XFER_PENDING             0xFF
+#endif
+
+#define _MANOMETER_I2C_SPEED_FAST           ( ( uint32_t )400000 )
+#define _MANOMETER_I2C_SPEED_STANDARD       ( ( uint32_t )100000 )
+#else
 extern const uint8_t _MANOMETER_CMD_RESET;
 extern const uint8_t _MANOMETER_CMD_ADC_READ;
 extern const uint8_t _MANOMETER_CMD_ADC_CONV;
@@ -70,10 +117,409 @@ extern const uint8_t _MANOMETER_OUTPUT_ADDRESS;
 
 extern const uint8_t _MANOMETER_I2C_ADDRESS;
 
+extern const uint8_t _MANOMETER_STATUS_NORMAL;
+extern const uint8_t _MANOMETER_STATUS_COMMAND;
+extern const uint8_t _MANOMETER_STATUS_STALE;
+extern const uint8_t _MANOMETER_STATUS_DIAGNOSTIC;
+
+extern const uint8_t _MANOMETER_OK;
+extern const uint8_t _MANOMETER_ERR_BUS;
+extern const uint8_t _MANOMETER_ERR_BUSY;
+extern const uint8_t _MANOMETER_ERR_PARAM;
+extern const uint8_t _MANOMETER_ERR_TIMEOUT;
+
+extern const float _MANOMETER_PRESSURE_ERROR;
+extern const float _MANOMETER_TEMPERATURE_ERROR;
+extern const int32_t _MANOMETER_PRESSURE_PA_ERROR;
+extern const int16_t _MANOMETER_TEMPERATURE_CENTI_ERROR;
+
+extern const uint8_t _MANOMETER_TRIGGER_RISING;
+extern const uint8_t _MANOMETER_TRIGGER_FALLING;
+extern const uint8_t _MANOMETER_TRIGGER_SLOPE;
+
+extern const uint8_t _MANOMETER_BURST_ARMED;
+extern const uint8_t _MANOMETER_BURST_TRIGGERED;
+extern const uint8_t _MANOMETER_BURST_DONE;
+
+#ifdef   __MANOMETER_TRACE__
+extern const uint8_t _MANOMETER_TRACE_START;
+extern const uint8_t _MANOMETER_TRACE_WRITE;
+extern const uint8_t _MANOMETER_TRACE_READ;
+extern const uint8_t _MANOMETER_TRACE_STOP;
+#endif
+
+#ifdef   __MANOMETER_DRV_I2C__
+extern const uint8_t _MANOMETER_XFER_PENDING;
+#endif
+
+extern const uint32_t _MANOMETER_I2C_SPEED_FAST;
+extern const uint32_t _MANOMETER_I2C_SPEED_STANDARD;
+#endif
+
                                                                        /** @} */
 /** @defgroup MANOMETER_TYPES Types */                             /** @{ */
 
+/**
+ * @brief Single sensor sample in raw counts
+ *
+ * status      - 2-bit sensor status ( _MANOMETER_STATUS_* )
+ * pressure    - 14-bit pressure count
+ * temperature - 11-bit temperature count
+ */
+typedef struct
+{
+    uint8_t  status;
+    uint16_t pressure;
+    uint16_t temperature;
+
+}T_MANOMETER_SAMPLE;
+
+/**
+ * @brief Burst capture context
+ *
+ * Circular buffer of raw pressure counts with a scope-like trigger.
+ * Buffer storage is provided by the application.
+ */
+typedef struct
+{
+    uint16_t *buffer;
+    uint16_t size;
+    uint16_t preTrigger;
+    uint16_t head;
+    uint16_t count;
+    uint16_t postCount;
+    uint16_t lastPressure;
+    int16_t  level;
+    uint8_t  triggerMode;
+    uint8_t  state;
+
+}T_MANOMETER_BURST;
+
+/**
+ * @brief Bus arbiter lock provided by the application
+ *
+ * Called with the transaction priority before every bus transaction;
+ * returns 0 when the bus is granted.
+ */
+typedef uint8_t (*T_MANOMETER_BUS_LOCK_FP)( uint8_t );
+
+/**
+ * @brief Bus arbiter unlock provided by the application
+ *
+ * Called after every granted bus transaction.
+ */
+typedef void (*T_MANOMETER_BUS_UNLOCK_FP)( void );
+
+/**
+ * @brief Bus clock setter provided by the application
+ *
+ * Called with the I2C clock in Hz; should re-initialize the I2C module.
+ */
+typedef void (*T_MANOMETER_BUS_SPEED_FP)( uint32_t );
+
+/**
+ * @brief Free-running time source provided by the application
+ *
+ * Returns current time in application units ( microseconds recommended ).
+ */
+typedef uint32_t (*T_MANOMETER_TIME_FP)( void );
+
+/**
+ * @brief Sensor instance on a shared I2C bus
+ *
+ * slaveAddress - 7-bit I2C address
+ * busSpeed     - negotiated I2C clock in Hz
+ * muxAddress   - 7-bit address of TCA9548A-style multiplexer ( 0 - none )
+ * muxChannel   - multiplexer channel ( 0 - 7 )
+ * tempCycle, lastTemperature - multi-rate temperature cache, kept by the driver
+ */
+typedef struct
+{
+    uint8_t  slaveAddress;
+    uint32_t busSpeed;
+    uint8_t  muxAddress;
+    uint8_t  muxChannel;
+    uint8_t  tempCycle;
+    uint16_t lastTemperature;
+
+}T_MANOMETER_SENSOR;
+
+/**
+ * @brief Synchronized sensor group
+ *
+ * Sensor list and per-sensor sample and offset storage are provided by
+ * the application. timestamp is the read time of the first sensor,
+ * offsets are read times relative to it and skew is the offset of the
+ * last sensor, all in time source units.
+ */
+typedef struct
+{
+    T_MANOMETER_SENSOR **sensors;
+    T_MANOMETER_SAMPLE *samples;
+    uint32_t           *offsets;
+    uint8_t            n;
+    uint8_t            withTemperature;
+    uint32_t           timestamp;
+    uint32_t           skew;
+
+}T_MANOMETER_GROUP;
+
+/**
+ * @brief Queued I2C transfer
+ *
+ * slaveAddress - 7-bit I2C address
+ * writeBuf     - bytes written first ( nWrite 0 - none )
+ * readBuf      - bytes read after a repeated start ( nRead 0 - none )
+ * priority     - higher value is served first
+ * busSpeed     - device clock [ Hz ] set before the transfer when a bus clock
+ *                handler is installed ( 0 - _MANOMETER_I2C_SPEED_STANDARD )
+ * status       - _MANOMETER_XFER_PENDING until served, then _MANOMETER_OK or _MANOMETER_ERR_BUS
+ */
+typedef struct
+{
+    uint8_t  slaveAddress;
+    uint8_t  *writeBuf;
+    uint16_t nWrite;
+    uint8_t  *readBuf;
+    uint16_t nRead;
+    uint8_t  priority;
+    uint32_t busSpeed;
+    uint8_t  status;
+
+}T_MANOMETER_XFER;
+
+/**
+ * @brief Shared I2C bus transfer queue
+ *
+ * Pending transfers of all drivers on the bus, ordered by priority and
+ * first come first served within a priority. Slot storage is provided
+ * by the application.
+ */
+typedef struct
+{
+    T_MANOMETER_XFER **slots;
+    uint8_t size;
+    uint8_t count;
+    uint8_t batchMax;
+
+}T_MANOMETER_QUEUE;
+
+#ifdef   __MANOMETER_TRACE__
+/**
+ * @brief Traced bus event
+ *
+ * time    - time source value when the HAL call started, on stop when the
+ *           transaction ended
+ * kind    - _MANOMETER_TRACE_START / _WRITE / _READ / _STOP
+ * address - 7-bit I2C address ( 0 on SPI )
+ * nBytes  - bytes transferred by write or read
+ * result  - HAL result ( negative on error ), on stop the driver result of the transaction
+ */
+typedef struct
+{
+    uint32_t time;
+    uint8_t  kind;
+    uint8_t  address;
+    uint16_t nBytes;
+    int16_t  result;
+
+}T_MANOMETER_TRACE_EVENT;
+
+/**
+ * @brief Bus transaction trace
+ *
+ * Circular event buffer provided by the application. When full the
+ * oldest events are overwritten and counted as lost.
+ */
+typedef struct
+{
+    T_MANOMETER_TRACE_EVENT *buffer;
+    uint16_t size;
+    uint16_t head;
+    uint16_t count;
+    uint32_t lost;
+
+}T_MANOMETER_TRACE;
+#endif
+
+#ifndef  __MANOMETER_MINIMAL__
+/**
+ * @brief Sliding window deque entry
+ */
+typedef struct
+{
+    uint16_t seq;
+    uint16_t value;
+
+}T_MANOMETER_DEQUE_ITEM;
+
+/**
+ * @brief Monotonic deque over application-provided storage
+ */
+typedef struct
+{
+    T_MANOMETER_DEQUE_ITEM *items;
+    uint16_t head;
+    uint16_t count;
+
+}T_MANOMETER_DEQUE;
+
+/**
+ * @brief Streaming statistics context
+ *
+ * Integer sums for mean/variance and monotonic-deque min/max over raw
+ * pressure counts. Sums are taken of the offset from the first sample
+ * of the window ( ref ), the sum of squares is 64-bit as a lo/hi pair.
+ * Both deques need window entries of storage.
+ */
+typedef struct
+{
+    T_MANOMETER_DEQUE minQ;
+    T_MANOMETER_DEQUE maxQ;
+    uint16_t window;
+    uint16_t seq;
+    uint16_t n;
+    uint16_t ref;
+    int32_t  sum;
+    uint32_t sumSqLo;
+    uint32_t sumSqHi;
+
+}T_MANOMETER_STATS;
+
+/**
+ * @brief Statistics of one closed window in mbar
+ */
+typedef struct
+{
+    float mean;
+    float stddev;
+    float min;
+    float max;
+
+}T_MANOMETER_STATS_RESULT;
+#endif
+
+/**
+ * @brief Fixed-memory pressure histogram
+ *
+ * Linear bins of 2^shift raw counts over the 14-bit pressure range.
+ * Bin storage ( 16384 >> shift entries ) is provided by the application.
+ */
+typedef struct
+{
+    uint32_t *bins;
+    uint16_t nBins;
+    uint8_t  shift;
+    uint32_t total;
+
+}T_MANOMETER_HISTOGRAM;
+
+#ifndef  __MANOMETER_MINIMAL__
+/**
+ * @brief Goertzel band state
+ *
+ * coeff     - 2cos( 2 pi f / fs ) in Q14
+ * amplitude - ripple amplitude of the last block in mbar
+ */
+typedef struct
+{
+    int32_t coeff;
+    int32_t s1;
+    int32_t s2;
+    float   amplitude;
+
+}T_MANOMETER_TONE;
+
+/**
+ * @brief Ripple analysis context
+ *
+ * Streaming fixed-point Goertzel bank over evenly-timed raw pressure
+ * samples. Only band state is kept, no sample block is stored.
+ */
+typedef struct
+{
+    T_MANOMETER_TONE *tones;
+    uint8_t  nTones;
+    uint16_t blockSize;
+    uint16_t n;
+    uint16_t offset;
+    int32_t  sum;
+
+}T_MANOMETER_RIPPLE;
+#endif
+
+/**
+ * @brief Deadband reporter context
+ *
+ * Raw pressure is reported only when it moved by more than threshold
+ * counts from the last reported value, or maxSilence time elapsed.
+ */
+typedef struct
+{
+    uint16_t threshold;
+    uint32_t maxSilence;
+    uint16_t lastValue;
+    uint32_t lastTime;
+    uint8_t  primed;
+
+}T_MANOMETER_DEADBAND;
+
+/**
+ * @brief Activity-adaptive sample rate controller
+ *
+ * Activity is the smoothed signed rate of change of raw pressure in
+ * counts per second, so sample noise averages out while sustained
+ * transients do not. Fast period is entered when its magnitude reaches
+ * enterRate and left below exitRate.
+ */
+typedef struct
+{
+    uint16_t slowPeriod;
+    uint16_t fastPeriod;
+    uint32_t enterRate;
+    uint32_t exitRate;
+    int32_t  activity;
+    uint16_t period;
+    uint16_t lastValue;
+    uint16_t switches;
+    uint8_t  primed;
 
+}T_MANOMETER_RATE;
+
+/**
+ * @brief Temperature compensation model
+ *
+ * Per-device correction of raw pressure counts over temperature:
+ *
+ *     p' = p + offset( x ) + ( p - 8192 ) * gain( x ),   x = ( t - tRef ) / 2048
+ *
+ * offset and gain are quadratic in x, coefficients [ c0, c1, c2 ] are
+ * Q16 counts for offset and Q24 for gain, magnitude below 2^30.
+ */
+typedef struct
+{
+    uint16_t tRef;
+    int32_t  offset[ 3 ];
+    int32_t  gain[ 3 ];
+
+}T_MANOMETER_COMP;
+
+/**
+ * @brief Two-state ( level, rate ) pressure filter context
+ *
+ * Steady-state Kalman filter of a constant-rate model, in fixed point.
+ * level is Q8 counts, rate Q16 counts per ms, alpha and beta Q15 gains.
+ */
+typedef struct
+{
+    int32_t  level;
+    int32_t  rate;
+    int32_t  alpha;
+    int32_t  beta;
+    uint32_t lastTime;
+    uint8_t  primed;
+
+}T_MANOMETER_KALMAN;
 
                                                                        /** @} */
 #ifdef __cplusplus
@@ -114,15 +560,20 @@ void manometer_writeData( uint8_t regAddress, uint32_t writeCommand );
  * @return    32-bit data from HSCMAND060PA3A3 sensor
  *
  * Function read byte of data from HSCMAND060PA3A3 sensor
+ *
+ * @note
+ * SPI variants have no register address, regAddress is ignored.
  */
 uint32_t manometer_readData( uint8_t regAddress );
 
+#ifndef  __MANOMETER_MINIMAL__
 /**
  * @brief Function read 16-bit data and convert to pressure in mbar
  *
  * @return         pressure value [ mbar ]
  *
- * Function read pressure value
+ * Function read pressure value, _MANOMETER_PRESSURE_ERROR when the
+ * bus read fails or is refused
  */
 float manometer_getPressure();
 
@@ -131,11 +582,774 @@ float manometer_getPressure();
  *
  * @return         temperature value in degrees Celsius [ C ]
  *
- * Function read temperature value
+ * Function read temperature value, _MANOMETER_TEMPERATURE_ERROR when the
+ * bus read fails or is refused
  */
 float manometer_getTemperature();
 
+/**
+ * @brief Function converts raw 14-bit pressure count to pressure in mbar
+ *
+ * @param[in] count    14-bit pressure count, higher bits ignored
+ *
+ * @return         pressure value [ mbar ]
+ *
+ * With __MANOMETER_LUT__ the value is interpolated from __manometer_lut.h.
+ */
+float manometer_countToPressure( uint16_t count );
+
+/**
+ * @brief Function converts raw 11-bit temperature count to temperature in degrees Celsius [ C ]
+ *
+ * @param[in] count    11-bit temperature count, higher bits ignored
+ *
+ * @return         temperature value in degrees Celsius [ C ]
+ *
+ * With __MANOMETER_LUT__ the value is interpolated from __manometer_lut.h.
+ */
+float manometer_countToTemperature( uint16_t count );
+#endif
+
+/**
+ * @brief Function converts raw 14-bit pressure count to pressure in Pa
+ *
+ * @param[in] count    14-bit pressure count, higher bits ignored
+ *
+ * @return         pressure value [ Pa ]
+ *
+ * Integer conversion, rounded to the nearest Pa ( 1 Pa = 0.01 mbar ).
+ */
+int32_t manometer_countToPascal( uint16_t count );
+
+/**
+ * @brief Function read 14-bit data and convert to pressure in Pa
+ *
+ * @return         pressure value [ Pa ]
+ *
+ * Function read pressure value without floating point arithmetic,
+ * _MANOMETER_PRESSURE_PA_ERROR when the bus read fails or is refused
+ */
+int32_t manometer_getPressurePa();
+
+/**
+ * @brief Function read raw 11-bit temperature count
+ *
+ * @param[out] count    11-bit temperature count
+ *
+ * @return    _MANOMETER_OK, _MANOMETER_ERR_BUS or _MANOMETER_ERR_BUSY
+ *
+ * Full resolution count for compensation pipelines, count is left
+ * unchanged on error.
+ */
+uint8_t manometer_getTemperatureRaw( uint16_t *count );
+
+/**
+ * @brief Function converts raw 11-bit temperature count to temperature in 0.01 C
+ *
+ * @param[in] count    11-bit temperature count, higher bits ignored
+ *
+ * @return         temperature value [ 0.01 C ]
+ *
+ * Integer conversion, rounded to the nearest 0.01 C.
+ */
+int16_t manometer_countToCentiCelsius( uint16_t count );
+
+/**
+ * @brief Function read 11-bit data and convert to temperature in 0.01 C
+ *
+ * @return         temperature value [ 0.01 C ]
+ *
+ * Function read temperature value without floating point arithmetic,
+ * _MANOMETER_TEMPERATURE_CENTI_ERROR when the bus read fails or is refused
+ */
+int16_t manometer_getTemperatureCenti();
+
+/**
+ * @brief Function read one raw sample from the sensor
+ *
+ * @param[out] sample    sample structure to fill
+ *
+ * @return    _MANOMETER_OK, _MANOMETER_ERR_BUS or _MANOMETER_ERR_BUSY
+ *
+ * Function reads the 4-byte output frame and decodes status,
+ * 14-bit pressure and 11-bit temperature counts.
+ */
+uint8_t manometer_readSample( T_MANOMETER_SAMPLE *sample );
+
+/**
+ * @brief Function sets temperature refresh rate for multi-rate acquisition
+ *
+ * @param[in] decimation    temperature is refreshed every decimation-th cycle
+ *
+ * Values 0 and 1 refresh temperature on every cycle.
+ */
+void manometer_setTemperatureDecimation( uint8_t decimation );
+
+/**
+ * @brief Function read one sample using multi-rate acquisition
+ *
+ * @param[out] sample    sample structure to fill
+ *
+ * @return    _MANOMETER_OK, _MANOMETER_ERR_BUS or _MANOMETER_ERR_BUSY
+ *
+ * Most cycles read only the 2 pressure bytes, every decimation-th cycle
+ * reads the full 4-byte frame. Temperature is taken from the
+ * last-known-temperature cache on pressure-only cycles. With sensor
+ * instances the cache is kept per sensor, so the first sample after
+ * selecting a new sensor reads its temperature.
+ */
+uint8_t manometer_readSampleMultiRate( T_MANOMETER_SAMPLE *sample );
+
+/**
+ * @brief Function returns last-known temperature
+ *
+ * @return    11-bit temperature count from the most recent full read
+ *
+ * Function does not access the bus.
+ */
+uint16_t manometer_getLastTemperature();
+
+/**
+ * @brief Function attaches driver to a shared bus arbiter
+ *
+ * @param[in] lock        arbiter lock function ( 0 - no arbitration )
+ * @param[in] unlock      arbiter unlock function
+ * @param[in] priority    priority passed to lock for this driver's transactions
+ *
+ * Each sensor transaction ( start, write, read, stop ) is issued as one
+ * atomic unit between lock and unlock, so the arbiter can serialize and
+ * order it against transfers of other drivers on the same bus.
+ * When lock is refused, data functions return _MANOMETER_ERR_BUSY.
+ */
+void manometer_setBusArbiter( T_MANOMETER_BUS_LOCK_FP lock, T_MANOMETER_BUS_UNLOCK_FP unlock, uint8_t priority );
+
+/**
+ * @brief Function sets the application time source
+ *
+ * @param[in] timeFp    function returning current time ( 0 - no time source )
+ *
+ * Used to timestamp synchronized group reads.
+ */
+void manometer_setTimeSource( T_MANOMETER_TIME_FP timeFp );
+
+#ifdef   __MANOMETER_DRV_I2C__
+/**
+ * @brief Function sets the application bus clock handler
+ *
+ * @param[in] handler    function re-initializing I2C with given clock
+ *
+ * Without a handler bus clock is left as configured by the application.
+ * With a bus queue every transfer is run at its own busSpeed and the
+ * clock of the selected sensor is restored after the batch.
+ */
+void manometer_setBusSpeedHandler( T_MANOMETER_BUS_SPEED_FP handler );
+
+/**
+ * @brief Function initializes sensor instance
+ *
+ * @param[out] sensor    sensor instance
+ * @param[in]  slave     7-bit I2C address
+ *
+ * Instance starts at standard mode clock ( 100 kHz ).
+ */
+void manometer_sensorInit( T_MANOMETER_SENSOR *sensor, uint8_t slave );
+
+/**
+ * @brief Function places sensor instance behind an I2C multiplexer
+ *
+ * @param[in] sensor        sensor instance
+ * @param[in] muxAddress    7-bit multiplexer address ( 0 - direct on bus )
+ * @param[in] muxChannel    multiplexer channel ( 0 - 7 )
+ */
+void manometer_sensorSetMux( T_MANOMETER_SENSOR *sensor, uint8_t muxAddress, uint8_t muxChannel );
+
+/**
+ * @brief Function selects sensor instance for following driver calls
+ *
+ * @param[in] sensor    sensor instance
+ *
+ * @return    _MANOMETER_OK, _MANOMETER_ERR_BUS or _MANOMETER_ERR_BUSY
+ *
+ * Bus clock is changed only when it differs from the current one, at
+ * the next transaction while the arbiter lock is held.
+ * Multiplexer channel is written only when it differs from the cached
+ * one; switching to another multiplexer first disables the previous one,
+ * and selecting a sensor without multiplexer disables the active one.
+ */
+uint8_t manometer_selectSensor( T_MANOMETER_SENSOR *sensor );
+
+/**
+ * @brief Function forgets cached multiplexer channel
+ *
+ * Call when another driver may have changed multiplexer channels;
+ * the next manometer_selectSensor() writes the channel again.
+ */
+void manometer_invalidateMux();
+
+/**
+ * @brief Function orders sensor list to minimize multiplexer switches
+ *
+ * @param[in] list    array of sensor instance pointers
+ * @param[in] n       number of sensors
+ *
+ * Sensors are grouped by multiplexer and channel, relative order inside
+ * a group is kept. Scanning the sorted list switches each channel once.
+ */
+void manometer_sortSensors( T_MANOMETER_SENSOR **list, uint8_t n );
+
+/**
+ * @brief Function negotiates fastest working bus clock for sensor
+ *
+ * @param[in] sensor    sensor instance
+ *
+ * @return    _MANOMETER_OK on success, _MANOMETER_ERR_BUS if no clock works
+ *            or the sensor cannot be selected, _MANOMETER_ERR_BUSY
+ *
+ * Function tries fast mode ( 400 kHz ) first and falls back to standard
+ * mode if verification reads fail. Result is kept in the instance and
+ * the sensor stays selected. An error of manometer_selectSensor() is
+ * returned unchanged.
+ */
+uint8_t manometer_negotiateSpeed( T_MANOMETER_SENSOR *sensor );
+
+/**
+ * @brief Function initializes synchronized sensor group
+ *
+ * @param[out] group              group context
+ * @param[in]  sensors            array of n sensor instance pointers
+ * @param[in]  samples            storage for n samples
+ * @param[in]  offsets            storage for n read time offsets
+ * @param[in]  n                  number of sensors
+ * @param[in]  withTemperature    1 - read temperature too, 0 - pressure only
+ *
+ * Pressure-only groups read 2 instead of 4 bytes per sensor, which
+ * shortens the skew across the group.
+ */
+void manometer_groupInit( T_MANOMETER_GROUP *group, T_MANOMETER_SENSOR **sensors, T_MANOMETER_SAMPLE *samples,
+                          uint32_t *offsets, uint8_t n, uint8_t withTemperature );
+
+/**
+ * @brief Function reads all sensors of the group back to back
+ *
+ * @param[in,out] group    group context
+ *
+ * @return    _MANOMETER_OK, _MANOMETER_ERR_BUS or _MANOMETER_ERR_BUSY
+ *
+ * Sensors are read in list order with nothing between the reads but
+ * sensor selection. Each read is timed at the middle of its transfer.
+ * On an error the read stops; samples from the failing sensor on keep
+ * their previous values.
+ */
+uint8_t manometer_groupRead( T_MANOMETER_GROUP *group );
+
+/**
+ * @brief Function returns pressure differential of two group members
+ *
+ * @param[in] group    group context
+ * @param[in] a        index of the first sensor
+ * @param[in] b        index of the second sensor
+ *
+ * @return    pressure count of a minus pressure count of b
+ */
+int16_t manometer_groupGetDifferential( T_MANOMETER_GROUP *group, uint8_t a, uint8_t b );
+
+/**
+ * @brief Function returns time skew of the last group read
+ *
+ * @param[in] group    group context
+ *
+ * @return    time between first and last sensor read in time source units
+ */
+uint32_t manometer_groupGetSkew( T_MANOMETER_GROUP *group );
+
+/**
+ * @brief Function initializes shared bus transfer queue
+ *
+ * @param[out] queue       queue context
+ * @param[in]  slots       storage for pending transfer pointers
+ * @param[in]  size        number of slots
+ * @param[in]  batchMax    transfers served per bus lock ( 0 - 1 )
+ */
+void manometer_queueInit( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER **slots, uint8_t size, uint8_t batchMax );
+
+/**
+ * @brief Function submits transfer to shared bus queue
+ *
+ * @param[in] queue    queue context
+ * @param[in] xfer     transfer, must stay valid until served
+ *
+ * @return    _MANOMETER_OK or _MANOMETER_ERR_BUSY when the queue is full
+ *
+ * Transfer status is _MANOMETER_XFER_PENDING until it is served.
+ *
+ * @note
+ * Queue functions are not reentrant. Submit, serve and issue driver
+ * transfers from one context only ( main loop or one task ); producers
+ * in interrupts or other tasks must be serialized by the application.
+ */
+uint8_t manometer_queueSubmit( T_MANOMETER_QUEUE *queue, T_MANOMETER_XFER *xfer );
+
+/**
+ * @brief Function serves pending transfers
+ *
+ * @param[in] queue    queue context
+ *
+ * @return    number of transfers served ( 0 - queue empty or bus refused )
+ *
+ * Up to batchMax transfers, most urgent first, run back to back under
+ * one arbiter lock. Each transfer is one start - stop transaction, so a
+ * transfer submitted later with a higher priority waits at most for the
+ * current batch; long transfers should be submitted in parts so urgent
+ * reads can be served between them.
+ */
+uint8_t manometer_queueService( T_MANOMETER_QUEUE *queue );
+
+/**
+ * @brief Function returns number of pending transfers
+ *
+ * @param[in] queue    queue context
+ *
+ * @return    pending transfers
+ */
+uint8_t manometer_queueGetCount( T_MANOMETER_QUEUE *queue );
+
+/**
+ * @brief Function routes driver transfers through a shared bus queue
+ *
+ * @param[in] queue    queue context ( 0 - direct bus access )
+ *
+ * Every driver transfer is submitted with the arbiter priority
+ * ( manometer_setBusArbiter() ) and the queue is served until it is
+ * done, so more urgent pending transfers of other drivers go first.
+ * When the bus is refused the transfer is withdrawn and the driver
+ * function returns _MANOMETER_ERR_BUSY.
+ */
+void manometer_setBusQueue( T_MANOMETER_QUEUE *queue );
+#endif
+
+/**
+ * @brief Function initializes burst capture
+ *
+ * @param[out] burst         burst capture context
+ * @param[in]  buffer        storage for raw pressure counts
+ * @param[in]  size          number of samples in buffer
+ * @param[in]  preTrigger    number of samples kept before the trigger
+ *
+ * Function sets up the capture buffer and arms the trigger
+ * ( default: rising level at full scale ).
+ */
+void manometer_burstInit( T_MANOMETER_BURST *burst, uint16_t *buffer, uint16_t size, uint16_t preTrigger );
+
+/**
+ * @brief Function sets burst trigger condition
+ *
+ * @param[in] burst    burst capture context
+ * @param[in] mode     _MANOMETER_TRIGGER_RISING / _FALLING / _SLOPE
+ * @param[in] level    threshold in counts, or slope in counts per sample
+ *
+ * Slope trigger fires when the sample-to-sample change reaches level;
+ * a negative level triggers on falling pressure.
+ */
+void manometer_burstSetTrigger( T_MANOMETER_BURST *burst, uint8_t mode, int16_t level );
+
+/**
+ * @brief Function re-arms burst capture
+ *
+ * @param[in] burst    burst capture context
+ */
+void manometer_burstArm( T_MANOMETER_BURST *burst );
+
+/**
+ * @brief Function performs one burst acquisition step
+ *
+ * @param[in] burst    burst capture context
+ *
+ * @return    _MANOMETER_BURST_ARMED / _TRIGGERED / _DONE
+ *
+ * Function reads one sample and stores it only when it is fresh,
+ * so calling it in a tight loop captures every new sensor conversion.
+ * Once done the buffer is frozen until manometer_burstArm() is called.
+ */
+uint8_t manometer_burstTask( T_MANOMETER_BURST *burst );
+
+/**
+ * @brief Function returns number of captured samples
+ *
+ * @param[in] burst    burst capture context
+ *
+ * @return    number of samples in capture window
+ */
+uint16_t manometer_burstGetCount( T_MANOMETER_BURST *burst );
+
+/**
+ * @brief Function returns position of trigger sample in capture window
+ *
+ * @param[in] burst    burst capture context
+ *
+ * @return    index of trigger sample ( valid when done )
+ */
+uint16_t manometer_burstGetTriggerIndex( T_MANOMETER_BURST *burst );
+
+/**
+ * @brief Function returns captured sample
+ *
+ * @param[in] burst    burst capture context
+ * @param[in] index    0 is the oldest sample in capture window
+ *
+ * @return    raw pressure count
+ */
+uint16_t manometer_burstGetSample( T_MANOMETER_BURST *burst, uint16_t index );
+
+
+#ifndef  __MANOMETER_MINIMAL__
+/**
+ * @brief Function initializes streaming statistics
+ *
+ * @param[out] stats     statistics context
+ * @param[in]  window    window length in samples
+ * @param[in]  minBuf    storage for window entries of min deque
+ * @param[in]  maxBuf    storage for window entries of max deque
+ */
+void manometer_statsInit( T_MANOMETER_STATS *stats, uint16_t window, T_MANOMETER_DEQUE_ITEM *minBuf, T_MANOMETER_DEQUE_ITEM *maxBuf );
+
+/**
+ * @brief Function adds raw pressure count to statistics
+ *
+ * @param[in] stats       statistics context
+ * @param[in] pressure    14-bit pressure count
+ *
+ * @return    1 when a window closed with this sample, 0 otherwise
+ *
+ * Update is O(1) amortized, integer only and uses no conversion to
+ * mbar; mean and variance restart on every window close, min/max keep
+ * sliding.
+ */
+uint8_t manometer_statsUpdate( T_MANOMETER_STATS *stats, uint16_t pressure );
+
+/**
+ * @brief Function returns statistics of the window that just closed
+ *
+ * @param[in]  stats     statistics context
+ * @param[out] result    mean, standard deviation, min and max in mbar
+ *
+ * Call right after manometer_statsUpdate() returned 1. Sums are
+ * converted to float here, once per window.
+ */
+void manometer_statsGetWindow( T_MANOMETER_STATS *stats, T_MANOMETER_STATS_RESULT *result );
+
+/**
+ * @brief Function returns sliding window minimum
+ *
+ * @param[in] stats    statistics context
+ *
+ * @return    minimum raw pressure count over the last window samples
+ */
+uint16_t manometer_statsGetMin( T_MANOMETER_STATS *stats );
 
+/**
+ * @brief Function returns sliding window maximum
+ *
+ * @param[in] stats    statistics context
+ *
+ * @return    maximum raw pressure count over the last window samples
+ */
+uint16_t manometer_statsGetMax( T_MANOMETER_STATS *stats );
+#endif
+
+/**
+ * @brief Function initializes pressure histogram
+ *
+ * @param[out] hist     histogram context
+ * @param[in]  bins     storage for 16384 >> shift bins
+ * @param[in]  shift    bin width as power of two ( 0 - 14 counts )
+ */
+void manometer_histInit( T_MANOMETER_HISTOGRAM *hist, uint32_t *bins, uint8_t shift );
+
+/**
+ * @brief Function adds raw pressure count to histogram
+ *
+ * @param[in] hist        histogram context
+ * @param[in] pressure    14-bit pressure count
+ */
+void manometer_histAdd( T_MANOMETER_HISTOGRAM *hist, uint16_t pressure );
+
+/**
+ * @brief Function merges one histogram into another
+ *
+ * @param[in] dst    histogram receiving the counts
+ * @param[in] src    histogram to add
+ *
+ * @return    _MANOMETER_OK, or _MANOMETER_ERR_PARAM if bin widths differ
+ *
+ * Merged quantiles are exactly those of the combined sample streams.
+ */
+uint8_t manometer_histMerge( T_MANOMETER_HISTOGRAM *dst, T_MANOMETER_HISTOGRAM *src );
+
+/**
+ * @brief Function estimates pressure quantile
+ *
+ * @param[in] hist       histogram context
+ * @param[in] permille   quantile in 1/1000 ( 500 - p50, 990 - p99 )
+ *
+ * @return    raw pressure count, interpolated inside the bin
+ *
+ * Error is at most half a bin width.
+ */
+uint16_t manometer_histGetQuantile( T_MANOMETER_HISTOGRAM *hist, uint16_t permille );
+
+#ifndef  __MANOMETER_MINIMAL__
+/**
+ * @brief Function initializes ripple analysis
+ *
+ * @param[out] ripple       ripple analysis context
+ * @param[in]  tones        storage for nTones band states
+ * @param[in]  nTones       number of bands
+ * @param[in]  blockSize    samples per analysis block ( up to 256 )
+ *
+ * Bands must be configured with manometer_rippleSetBand() before use.
+ */
+void manometer_rippleInit( T_MANOMETER_RIPPLE *ripple, T_MANOMETER_TONE *tones, uint8_t nTones, uint16_t blockSize );
+
+/**
+ * @brief Function sets analysis frequency of one band
+ *
+ * @param[in] ripple        ripple analysis context
+ * @param[in] band          band index
+ * @param[in] frequency     band center frequency in Hz
+ * @param[in] sampleRate    sample rate in Hz
+ *
+ * Frequency resolution is sampleRate / blockSize.
+ */
+void manometer_rippleSetBand( T_MANOMETER_RIPPLE *ripple, uint8_t band, float frequency, float sampleRate );
+
+/**
+ * @brief Function adds raw pressure sample to ripple analysis
+ *
+ * @param[in] ripple      ripple analysis context
+ * @param[in] pressure    14-bit pressure count, sampled at fixed rate
+ *
+ * @return    1 when a block completed and band amplitudes were updated
+ *
+ * Per-sample cost is one fixed-point multiply-add per band. The mean of
+ * the previous block is removed to keep the integer state small.
+ */
+uint8_t manometer_rippleUpdate( T_MANOMETER_RIPPLE *ripple, uint16_t pressure );
+
+/**
+ * @brief Function returns ripple amplitude of one band
+ *
+ * @param[in] ripple    ripple analysis context
+ * @param[in] band      band index
+ *
+ * @return    amplitude of the last completed block in mbar
+ */
+float manometer_rippleGetAmplitude( T_MANOMETER_RIPPLE *ripple, uint8_t band );
+#endif
+
+/**
+ * @brief Function initializes deadband reporter
+ *
+ * @param[out] deadband      deadband context
+ * @param[in]  threshold     minimal change in raw counts to report
+ * @param[in]  maxSilence    maximal time between reports ( 0 - no limit )
+ *
+ * Time unit is whatever the application passes to manometer_deadbandUpdate().
+ */
+void manometer_deadbandInit( T_MANOMETER_DEADBAND *deadband, uint16_t threshold, uint32_t maxSilence );
+
+/**
+ * @brief Function checks whether a new sample should be reported
+ *
+ * @param[in] deadband    deadband context
+ * @param[in] pressure    14-bit pressure count
+ * @param[in] now         current time
+ *
+ * @return    1 if sample should be reported, 0 otherwise
+ *
+ * First sample is always reported. Reported sample becomes the new reference.
+ */
+uint8_t manometer_deadbandUpdate( T_MANOMETER_DEADBAND *deadband, uint16_t pressure, uint32_t now );
+
+/**
+ * @brief Function initializes sample rate controller
+ *
+ * @param[out] rate          rate controller context
+ * @param[in]  slowPeriod    sample period in steady state [ ms ]
+ * @param[in]  fastPeriod    sample period during transients [ ms ]
+ * @param[in]  enterRate     activity to switch to fast period [ counts/s ]
+ * @param[in]  exitRate      activity to return to slow period [ counts/s ]
+ *
+ * exitRate should be below enterRate to get hysteresis.
+ */
+void manometer_rateInit( T_MANOMETER_RATE *rate, uint16_t slowPeriod, uint16_t fastPeriod, uint32_t enterRate, uint32_t exitRate );
+
+/**
+ * @brief Function updates rate controller with new sample
+ *
+ * @param[in] rate        rate controller context
+ * @param[in] pressure    14-bit pressure count
+ *
+ * @return    period until next read [ ms ]
+ */
+uint16_t manometer_rateUpdate( T_MANOMETER_RATE *rate, uint16_t pressure );
+
+/**
+ * @brief Function returns current sample period
+ *
+ * @param[in] rate    rate controller context
+ *
+ * @return    current sample period [ ms ]
+ */
+uint16_t manometer_rateGetPeriod( T_MANOMETER_RATE *rate );
+
+/**
+ * @brief Function returns number of rate switches
+ *
+ * @param[in] rate    rate controller context
+ *
+ * @return    number of slow/fast transitions since init
+ */
+uint16_t manometer_rateGetSwitches( T_MANOMETER_RATE *rate );
+
+/**
+ * @brief Function waits for the first valid sample after power-up
+ *
+ * @param[in]  timeout        maximal number of polls after the first one
+ * @param[out] timeToReady    time until first valid sample, see below
+ *
+ * @return    _MANOMETER_OK, or _MANOMETER_ERR_TIMEOUT
+ *
+ * Function polls the sensor, with a 1 ms delay between reads, until it
+ * answers with normal, non-stale status. Use instead of a fixed
+ * start-up delay. With a time source set ( manometer_setTimeSource() )
+ * timeToReady is the elapsed time in its units, read time included and
+ * limited to 65535. Without one it is the number of 1 ms delays, a lower
+ * bound in ms that leaves out the read time of every poll.
+ */
+uint8_t manometer_waitReady( uint16_t timeout, uint16_t *timeToReady );
+
+/**
+ * @brief Function initializes temperature compensation
+ *
+ * @param[out] comp      compensation context
+ * @param[in]  tRef      reference temperature count of the fit
+ * @param[in]  offset    offset coefficients [ c0, c1, c2 ] in Q16 counts
+ * @param[in]  gain      gain coefficients [ c0, c1, c2 ] in Q24
+ *
+ * Coefficients are fitted on the host by Click_Manometer_compfit.
+ */
+void manometer_compInit( T_MANOMETER_COMP *comp, uint16_t tRef, int32_t *offset, int32_t *gain );
+
+/**
+ * @brief Function applies temperature compensation to one sample
+ *
+ * @param[in]     comp      compensation context
+ * @param[in,out] sample    sample read by manometer_readSample()
+ *
+ * @return    compensated pressure count
+ *
+ * Pressure of the sample is corrected in place using the temperature
+ * count of the same frame, the result is clamped to the 14-bit range.
+ */
+uint16_t manometer_compApply( T_MANOMETER_COMP *comp, T_MANOMETER_SAMPLE *sample );
+
+/**
+ * @brief Function initializes pressure filter with explicit gains
+ *
+ * @param[out] kalman    filter context
+ * @param[in]  alpha     level gain in Q15 ( 0 - 32768 )
+ * @param[in]  beta      rate gain in Q15 ( 0 - 65535 )
+ */
+void manometer_kalmanInit( T_MANOMETER_KALMAN *kalman, uint16_t alpha, uint16_t beta );
+
+#ifndef  __MANOMETER_MINIMAL__
+/**
+ * @brief Function sets filter gains from noise parameters
+ *
+ * @param[in,out] kalman        filter context
+ * @param[in]     accelNoise    process noise, pressure acceleration [ counts / s^2 ]
+ * @param[in]     measNoise     measurement noise [ counts rms ]
+ * @param[in]     period        nominal sample period [ ms ]
+ *
+ * Gains are the steady-state Kalman gains of the constant-rate model.
+ * Higher accelNoise / measNoise follows faster, lower smooths more.
+ */
+void manometer_kalmanTune( T_MANOMETER_KALMAN *kalman, float accelNoise, float measNoise, uint16_t period );
+#endif
+
+/**
+ * @brief Function feeds one sample to the pressure filter
+ *
+ * @param[in,out] kalman      filter context
+ * @param[in]     pressure    raw pressure count
+ * @param[in]     now         sample time [ ms ]
+ *
+ * @return    filtered pressure count
+ *
+ * Prediction uses the actual time since the previous sample. A sample
+ * with an earlier time than the previous one, or more than 10 s after
+ * it, restarts the filter at the measured pressure.
+ */
+uint16_t manometer_kalmanUpdate( T_MANOMETER_KALMAN *kalman, uint16_t pressure, uint32_t now );
+
+/**
+ * @brief Function returns estimated pressure rate
+ *
+ * @param[in] kalman    filter context
+ *
+ * @return    rate of change [ counts / s ]
+ */
+int32_t manometer_kalmanGetRate( T_MANOMETER_KALMAN *kalman );
+
+
+#ifdef   __MANOMETER_TRACE__
+/**
+ * @brief Function starts bus transaction tracing
+ *
+ * @param[out] trace     trace context
+ * @param[in]  buffer    storage for events
+ * @param[in]  size      number of events in buffer
+ *
+ * Every driver start, write, read and stop is recorded from now on,
+ * time stamped with the time source ( manometer_setTimeSource() ).
+ */
+void manometer_traceInit( T_MANOMETER_TRACE *trace, T_MANOMETER_TRACE_EVENT *buffer, uint16_t size );
+
+/**
+ * @brief Function stops bus transaction tracing
+ *
+ * Recorded events stay in the trace context.
+ */
+void manometer_traceStop();
+
+/**
+ * @brief Function returns number of recorded events
+ *
+ * @param[in] trace    trace context
+ *
+ * @return    number of events in buffer
+ */
+uint16_t manometer_traceGetCount( T_MANOMETER_TRACE *trace );
+
+/**
+ * @brief Function returns recorded event
+ *
+ * @param[in] trace    trace context
+ * @param[in] index    0 is the oldest event in buffer
+ *
+ * @return    pointer to event
+ */
+T_MANOMETER_TRACE_EVENT *manometer_traceGetEvent( T_MANOMETER_TRACE *trace, uint16_t index );
+
+/**
+ * @brief Function returns number of overwritten events
+ *
+ * @param[in] trace    trace context
+ *
+ * @return    events lost since manometer_traceInit()
+ */
+uint32_t manometer_traceGetLost( T_MANOMETER_TRACE *trace );
+#endif
 
 
                                                                        /** @} */
@@ -44,8 +44,11 @@
 /** @defgroup MANOMETER_HAL_COMPILE HAL Cofiguration */            /** @{ */
 
 //                #define   __HAL_SPI__                            /**<     @macro __HAL_SPI__  @brief SPI HAL selector */                
-                 #define   __HAL_I2C__                            /**<     @macro __HAL_I2C__  @brief I2C HAL selector */
+//               #define   __HAL_I2C__                            /**<     @macro __HAL_I2C__  @brief I2C HAL selector */
 //               #define   __HAL_UART__                           /**<     @macro __HAL_UART__  @brief UART HAL selector */                          
+//               #define   __HAL_STATIC__                         /**<     @macro __HAL_STATIC__  @brief Compile-time HAL binding */
+//               #define   __HAL_REPLAY__                         /**<     @macro __HAL_REPLAY__  @brief Recorded frame replay ( host ) */
+//               #define   __HAL_SIM__                            /**<     @macro __HAL_SIM__  @brief Simulated I2C bus ( host ) */
 
 // #define   __AN_PIN_INPUT__          0
 // #define   __RST_PIN_INPUT__         1
@@ -72,6 +75,15 @@
 // #define   __TX_PIN_OUTPUT__         9
 // #define   __SCL_PIN_OUTPUT__        10                                    
 // #define   __SDA_PIN_OUTPUT__        11    
+
+/* HAL follows the driver transport selector */
+#ifdef   __MANOMETER_DRV_SPI__
+#define   __HAL_SPI__
+#define   __CS_PIN_OUTPUT__         2
+#endif
+#ifdef   __MANOMETER_DRV_I2C__
+#define   __HAL_I2C__
+#endif
                                                                        /** @} */
 #ifdef __HAL_SPI__
 
@@ -242,6 +254,8 @@ typedef struct
   
 }T_hal_gpioObj;
 
+#ifndef __HAL_STATIC__
+
 #ifdef __AN_PIN_INPUT__
 static T_hal_gpioGetFp          hal_gpio_anGet; 
 #endif
@@ -322,6 +336,9 @@ static void hal_gpioMap(T_HAL_P gpioObj)
 {
     T_HAL_GPIO_OBJ tmp = (T_HAL_GPIO_OBJ)gpioObj;
 
+    // Referenced only by the pins mapped below, none on host backends
+    (void)tmp;
+
 #ifdef __AN_PIN_INPUT__
     hal_gpio_anGet = tmp->gpioGet[ __AN_PIN_INPUT__ ];
 #endif
@@ -395,7 +412,113 @@ static void hal_gpioMap(T_HAL_P gpioObj)
     hal_gpio_sdaSet = tmp->gpioSet[ __SDA_PIN_OUTPUT__ ];
 #endif
 }
+
+#else
+
+/*
+ * Static binding - every HAL call resolves at compile time to the
+ * HAL_STATIC_* macros of __manometer_hal_static.h, so there are no
+ * function pointers to map and the compiler can inline the bus calls.
+ */
+#include "__manometer_hal_static.h"
+
+#define hal_gpioMap(gpioObj)
+
+#ifdef __AN_PIN_INPUT__
+#define hal_gpio_anGet()                        HAL_STATIC_AN_GET()
+#endif
+#ifdef __CS_PIN_INPUT__
+#define hal_gpio_csGet()                        HAL_STATIC_CS_GET()
+#endif
+#ifdef __RST_PIN_INPUT__
+#define hal_gpio_rstGet()                       HAL_STATIC_RST_GET()
+#endif
+#ifdef __SCK_PIN_INPUT__
+#define hal_gpio_sckGet()                       HAL_STATIC_SCK_GET()
+#endif
+#ifdef __MISO_PIN_INPUT__
+#define hal_gpio_misoGet()                      HAL_STATIC_MISO_GET()
+#endif
+#ifdef __MOSI_PIN_INPUT__
+#define hal_gpio_mosiGet()                      HAL_STATIC_MOSI_GET()
+#endif
+#ifdef __PWM_PIN_INPUT__
+#define hal_gpio_pwmGet()                       HAL_STATIC_PWM_GET()
+#endif
+#ifdef __INT_PIN_INPUT__
+#define hal_gpio_intGet()                       HAL_STATIC_INT_GET()
+#endif
+#ifdef __RX_PIN_INPUT__
+#define hal_gpio_rxGet()                        HAL_STATIC_RX_GET()
+#endif
+#ifdef __TX_PIN_INPUT__
+#define hal_gpio_txGet()                        HAL_STATIC_TX_GET()
+#endif
+#ifdef __SCL_PIN_INPUT__
+#define hal_gpio_sclGet()                       HAL_STATIC_SCL_GET()
+#endif
+#ifdef __SDA_PIN_INPUT__
+#define hal_gpio_sdaGet()                       HAL_STATIC_SDA_GET()
+#endif
+#ifdef __AN_PIN_OUTPUT__
+#define hal_gpio_anSet(state)                   HAL_STATIC_AN_SET(state)
+#endif
+#ifdef __CS_PIN_OUTPUT__
+#define hal_gpio_csSet(state)                   HAL_STATIC_CS_SET(state)
+#endif
+#ifdef __RST_PIN_OUTPUT__
+#define hal_gpio_rstSet(state)                  HAL_STATIC_RST_SET(state)
+#endif
+#ifdef __SCK_PIN_OUTPUT__
+#define hal_gpio_sckSet(state)                  HAL_STATIC_SCK_SET(state)
+#endif
+#ifdef __MISO_PIN_OUTPUT__
+#define hal_gpio_misoSet(state)                 HAL_STATIC_MISO_SET(state)
+#endif
+#ifdef __MOSI_PIN_OUTPUT__
+#define hal_gpio_mosiSet(state)                 HAL_STATIC_MOSI_SET(state)
+#endif
+#ifdef __PWM_PIN_OUTPUT__
+#define hal_gpio_pwmSet(state)                  HAL_STATIC_PWM_SET(state)
+#endif
+#ifdef __INT_PIN_OUTPUT__
+#define hal_gpio_intSet(state)                  HAL_STATIC_INT_SET(state)
+#endif
+#ifdef __RX_PIN_OUTPUT__
+#define hal_gpio_rxSet(state)                   HAL_STATIC_RX_SET(state)
+#endif
+#ifdef __TX_PIN_OUTPUT__
+#define hal_gpio_txSet(state)                   HAL_STATIC_TX_SET(state)
+#endif
+#ifdef __SCL_PIN_OUTPUT__
+#define hal_gpio_sclSet(state)                  HAL_STATIC_SCL_SET(state)
+#endif
+#ifdef __SDA_PIN_OUTPUT__
+#define hal_gpio_sdaSet(state)                  HAL_STATIC_SDA_SET(state)
+#endif
+#ifdef __HAL_SPI__
+#define hal_spiMap(spiObj)
+#define hal_spiWrite(pBuf, nBytes)              HAL_STATIC_SPI_WRITE(pBuf, nBytes)
+#define hal_spiRead(pBuf, nBytes)               HAL_STATIC_SPI_READ(pBuf, nBytes)
+#define hal_spiTransfer(pIn, pOut, nBytes)      HAL_STATIC_SPI_TRANSFER(pIn, pOut, nBytes)
+#endif
+#ifdef __HAL_I2C__
+#define hal_i2cMap(i2cObj)
+#define hal_i2cStart()                          HAL_STATIC_I2C_START()
+#define hal_i2cWrite(addr, pBuf, nBytes, mode)  HAL_STATIC_I2C_WRITE(addr, pBuf, nBytes, mode)
+#define hal_i2cRead(addr, pBuf, nBytes, mode)   HAL_STATIC_I2C_READ(addr, pBuf, nBytes, mode)
+#endif
+#ifdef __HAL_UART__
+#define hal_uartMap(uartObj)
+#define hal_uartWrite(input)                    HAL_STATIC_UART_WRITE(input)
+#define hal_uartRead()                          HAL_STATIC_UART_READ()
+#define hal_uartReady()                         HAL_STATIC_UART_READY()
+#endif
+
+#endif
                                                                        /** @} */
+#ifndef __HAL_STATIC__
+
 #ifdef __MIKROC_PRO_FOR_PIC__
 #include "__HAL_PIC.c"
 #endif
@@ -448,6 +571,20 @@ static void hal_gpioMap(T_HAL_P gpioObj)
 #endif
 #endif
 
+#ifdef __HAL_REPLAY__
+#include "__HAL_REPLAY.c"
+#else
+#ifdef __HAL_SIM__
+#include "__HAL_SIM.c"
+#else
+#ifdef __linux__
+#include "__HAL_LINUX.c"
+#endif
+#endif
+#endif
+
+#endif
+
 /* -------------------------------------------------------------------------- */
 /*
   __manometer_hal.c
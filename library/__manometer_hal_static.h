@@ -0,0 +1,300 @@
+/*
+    __manometer_hal_static.h
+
+-----------------------------------------------------------------------------
+
+  This file is part of mikroSDK.
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+----------------------------------------------------------------------------- */
+
+/**
+@file   __manometer_hal_static.h
+@brief  Compile-time HAL binding
+
+Used instead of the runtime-mapped HAL when __HAL_STATIC__ is defined.
+Each HAL_STATIC_* macro names the target library routine or pin directly,
+so bus and GPIO calls are direct calls the compiler can inline.
+Edit the bindings for the board in use - every pin selected in
+__manometer_hal.c and the selected bus must be bound here. Bus helpers
+are compiled only for the bus the driver is built for.
+
+Bindings are given for the example boards, mikroBUS 1:
+
+- mikroC ARM, STM32       EasyMx PRO v7 for STM32, I2C1 / SPI3, CS PD13
+- mikroC PIC, PIC18       EasyPIC PRO v7, MSSP1 ( I2C1 / SPI1 ), CS RE0
+- mikroC AVR, ATmega      EasyAVR v7, TWI / SPI1, CS PA5
+
+PIC and AVR libraries have no buffer transfer, so their I2C helpers
+send the address and data bytes themselves and issue the repeated start
+before a read that follows a write. Check the CS pin against the board
+schematic before use.
+
+Measuring the gain: build the target example twice, with and without
+__HAL_STATIC__, same optimization level. Flash is "Used ROM" in the
+compiler statistics. Cycles are read from the simulator or debugger
+stopwatch across one manometer_readSample() call, with the bus library
+stubbed out in the simulator so the bus time does not hide the call
+overhead.
+*/
+/* -------------------------------------------------------------------------- */
+
+#ifndef _MANOMETER_HAL_STATIC_H_
+#define _MANOMETER_HAL_STATIC_H_
+
+#ifdef __MIKROC_PRO_FOR_ARM__
+#ifdef __STM32__
+
+/* EasyMx PRO v7 for STM32, mikroBUS 1 */
+
+#define HAL_STATIC_CS_SET(state)                ( GPIOD_ODR.B13 = ( state ) )
+
+#ifdef __HAL_I2C__
+#define HAL_STATIC_I2C_START()                  I2C1_Start()
+#define HAL_STATIC_I2C_WRITE(addr, pBuf, nBytes, mode)  I2C1_Write( addr, pBuf, nBytes, mode )
+#define HAL_STATIC_I2C_READ(addr, pBuf, nBytes, mode)   I2C1_Read( addr, pBuf, nBytes, mode )
+#endif
+
+#ifdef __HAL_SPI__
+static void hal_static_spiWrite(uint8_t *pBuf, uint16_t nBytes)
+{
+    while( nBytes-- )
+        SPI3_Write( *pBuf++ );
+}
+
+static void hal_static_spiRead(uint8_t *pBuf, uint16_t nBytes)
+{
+    while( nBytes-- )
+        *pBuf++ = SPI3_Read( 0x00 );
+}
+
+#define HAL_STATIC_SPI_WRITE(pBuf, nBytes)      hal_static_spiWrite( pBuf, nBytes )
+#define HAL_STATIC_SPI_READ(pBuf, nBytes)       hal_static_spiRead( pBuf, nBytes )
+#endif
+
+#define _MANOMETER_HAL_STATIC_BOUND_
+#endif
+#endif
+
+#ifdef __MIKROC_PRO_FOR_PIC__
+
+/* EasyPIC PRO v7 ( P18F87K22 ), mikroBUS 1 */
+
+#define HAL_STATIC_CS_SET(state)                ( LATE0_bit = ( state ) )
+
+#ifdef __HAL_I2C__
+#ifndef END_MODE_STOP
+#define END_MODE_STOP                           0
+#endif
+#ifndef END_MODE_RESTART
+#define END_MODE_RESTART                        1
+#endif
+
+static uint8_t hal_static_i2cFresh;
+
+static int hal_static_i2cStart()
+{
+    hal_static_i2cFresh = 1;
+
+    return I2C1_Start();
+}
+
+static int hal_static_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    uint8_t res;
+
+    hal_static_i2cFresh = 0;
+    res = I2C1_Wr( slaveAddress << 1 );
+    while( nBytes-- && !res )
+        res = I2C1_Wr( *pBuf++ );
+    if( ( endMode == END_MODE_STOP ) || res )
+        I2C1_Stop();
+
+    return res;
+}
+
+static int hal_static_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    uint8_t res;
+
+    if( !hal_static_i2cFresh )
+        I2C1_Repeated_Start();
+    hal_static_i2cFresh = 0;
+    res = I2C1_Wr( ( slaveAddress << 1 ) | 1 );
+    if( res )
+    {
+        I2C1_Stop();
+        return res;
+    }
+    while( nBytes-- )
+        *pBuf++ = I2C1_Rd( nBytes != 0 );
+    if( endMode == END_MODE_STOP )
+        I2C1_Stop();
+
+    return 0;
+}
+
+#define HAL_STATIC_I2C_START()                  hal_static_i2cStart()
+#define HAL_STATIC_I2C_WRITE(addr, pBuf, nBytes, mode)  hal_static_i2cWrite( addr, pBuf, nBytes, mode )
+#define HAL_STATIC_I2C_READ(addr, pBuf, nBytes, mode)   hal_static_i2cRead( addr, pBuf, nBytes, mode )
+#endif
+
+#ifdef __HAL_SPI__
+static void hal_static_spiWrite(uint8_t *pBuf, uint16_t nBytes)
+{
+    while( nBytes-- )
+        SPI1_Write( *pBuf++ );
+}
+
+static void hal_static_spiRead(uint8_t *pBuf, uint16_t nBytes)
+{
+    while( nBytes-- )
+        *pBuf++ = SPI1_Read( 0x00 );
+}
+
+#define HAL_STATIC_SPI_WRITE(pBuf, nBytes)      hal_static_spiWrite( pBuf, nBytes )
+#define HAL_STATIC_SPI_READ(pBuf, nBytes)       hal_static_spiRead( pBuf, nBytes )
+#endif
+
+#define _MANOMETER_HAL_STATIC_BOUND_
+#endif
+
+#ifdef __MIKROC_PRO_FOR_AVR__
+
+/* EasyAVR v7 ( ATMEGA32 ), mikroBUS 1 */
+
+#define HAL_STATIC_CS_SET(state)                ( PORTA5_bit = ( state ) )
+
+#ifdef __HAL_I2C__
+#ifndef END_MODE_STOP
+#define END_MODE_STOP                           0
+#endif
+#ifndef END_MODE_RESTART
+#define END_MODE_RESTART                        1
+#endif
+
+/* TWI status codes: address acknowledged for write / read, data acknowledged */
+#define HAL_STATIC_TWI_SLA_W_ACK                0x18
+#define HAL_STATIC_TWI_SLA_R_ACK                0x40
+#define HAL_STATIC_TWI_DATA_ACK                 0x28
+
+static uint8_t hal_static_i2cFresh;
+
+static int hal_static_i2cStart()
+{
+    hal_static_i2cFresh = 1;
+
+    return TWI_Start();
+}
+
+static int hal_static_i2cWrite(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    uint8_t res = 0;
+
+    hal_static_i2cFresh = 0;
+    TWI_Write( slaveAddress << 1 );
+    if( ( TWI_Status() & 0xF8 ) != HAL_STATIC_TWI_SLA_W_ACK )
+        res = 1;
+    while( nBytes-- && !res )
+    {
+        TWI_Write( *pBuf++ );
+        if( ( TWI_Status() & 0xF8 ) != HAL_STATIC_TWI_DATA_ACK )
+            res = 1;
+    }
+    if( ( endMode == END_MODE_STOP ) || res )
+        TWI_Stop();
+
+    return res;
+}
+
+static int hal_static_i2cRead(uint8_t slaveAddress, uint8_t *pBuf, uint16_t nBytes, uint8_t endMode)
+{
+    if( !hal_static_i2cFresh )
+        TWI_Start();
+    hal_static_i2cFresh = 0;
+    TWI_Write( ( slaveAddress << 1 ) | 1 );
+    if( ( TWI_Status() & 0xF8 ) != HAL_STATIC_TWI_SLA_R_ACK )
+    {
+        TWI_Stop();
+        return 1;
+    }
+    while( nBytes-- )
+        *pBuf++ = TWI_Read( nBytes != 0 );
+    if( endMode == END_MODE_STOP )
+        TWI_Stop();
+
+    return 0;
+}
+
+#define HAL_STATIC_I2C_START()                  hal_static_i2cStart()
+#define HAL_STATIC_I2C_WRITE(addr, pBuf, nBytes, mode)  hal_static_i2cWrite( addr, pBuf, nBytes, mode )
+#define HAL_STATIC_I2C_READ(addr, pBuf, nBytes, mode)   hal_static_i2cRead( addr, pBuf, nBytes, mode )
+#endif
+
+#ifdef __HAL_SPI__
+static void hal_static_spiWrite(uint8_t *pBuf, uint16_t nBytes)
+{
+    while( nBytes-- )
+        SPI1_Write( *pBuf++ );
+}
+
+static void hal_static_spiRead(uint8_t *pBuf, uint16_t nBytes)
+{
+    while( nBytes-- )
+        *pBuf++ = SPI1_Read( 0x00 );
+}
+
+#define HAL_STATIC_SPI_WRITE(pBuf, nBytes)      hal_static_spiWrite( pBuf, nBytes )
+#define HAL_STATIC_SPI_READ(pBuf, nBytes)       hal_static_spiRead( pBuf, nBytes )
+#endif
+
+#define _MANOMETER_HAL_STATIC_BOUND_
+#endif
+
+#ifndef _MANOMETER_HAL_STATIC_BOUND_
+#error "__HAL_STATIC__ : no HAL_STATIC_* bindings for this target in __manometer_hal_static.h"
+#endif
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/*
+  __manometer_hal_static.h
+
+  Copyright (c) 2017, MikroElektonika - http://www.mikroe.com
+
+  All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+3. All advertising materials mentioning features or use of this software
+   must display the following acknowledgement:
+   This product includes software developed by the MikroElektonika.
+
+4. Neither the name of the MikroElektonika nor the
+   names of its contributors may be used to endorse or promote products
+   derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY MIKROELEKTRONIKA ''AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL MIKROELEKTRONIKA BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------- */
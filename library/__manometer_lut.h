@@ -0,0 +1,66 @@
+/*
+    __manometer_lut.h
+
+    Generated by Click_Manometer_lutgen -p 0 417700 -o 1638 14745 -c 0 1
+    Do not edit, regenerate for another part or calibration.
+*/
+
+#ifndef _MANOMETER_LUT_H_
+#define _MANOMETER_LUT_H_
+
+#define _LUT_PRESSURE_SHIFT       6
+#define _LUT_TEMPERATURE_SHIFT    5
+
+// Pressure [ Pa ] at count i * 2^_LUT_PRESSURE_SHIFT
+static const int32_t _lutPressure[ 257 ] =
+{
+     -52201,  -50161,  -48121,  -46082,  -44042,  -42003,  -39963,  -37923,
+     -35884,  -33844,  -31805,  -29765,  -27726,  -25686,  -23646,  -21607,
+     -19567,  -17528,  -15488,  -13448,  -11409,   -9369,   -7330,   -5290,
+      -3251,   -1211,     829,    2868,    4908,    6947,    8987,   11026,
+      13066,   15106,   17145,   19185,   21224,   23264,   25304,   27343,
+      29383,   31422,   33462,   35501,   37541,   39581,   41620,   43660,
+      45699,   47739,   49779,   51818,   53858,   55897,   57937,   59976,
+      62016,   64056,   66095,   68135,   70174,   72214,   74254,   76293,
+      78333,   80372,   82412,   84451,   86491,   88531,   90570,   92610,
+      94649,   96689,   98729,  100768,  102808,  104847,  106887,  108926,
+     110966,  113006,  115045,  117085,  119124,  121164,  123203,  125243,
+     127283,  129322,  131362,  133401,  135441,  137481,  139520,  141560,
+     143599,  145639,  147678,  149718,  151758,  153797,  155837,  157876,
+     159916,  161956,  163995,  166035,  168074,  170114,  172153,  174193,
+     176233,  178272,  180312,  182351,  184391,  186431,  188470,  190510,
+     192549,  194589,  196628,  198668,  200708,  202747,  204787,  206826,
+     208866,  210906,  212945,  214985,  217024,  219064,  221103,  223143,
+     225183,  227222,  229262,  231301,  233341,  235380,  237420,  239460,
+     241499,  243539,  245578,  247618,  249658,  251697,  253737,  255776,
+     257816,  259855,  261895,  263935,  265974,  268014,  270053,  272093,
+     274133,  276172,  278212,  280251,  282291,  284330,  286370,  288410,
+     290449,  292489,  294528,  296568,  298608,  300647,  302687,  304726,
+     306766,  308805,  310845,  312885,  314924,  316964,  319003,  321043,
+     323083,  325122,  327162,  329201,  331241,  333280,  335320,  337360,
+     339399,  341439,  343478,  345518,  347558,  349597,  351637,  353676,
+     355716,  357755,  359795,  361835,  363874,  365914,  367953,  369993,
+     372032,  374072,  376112,  378151,  380191,  382230,  384270,  386310,
+     388349,  390389,  392428,  394468,  396507,  398547,  400587,  402626,
+     404666,  406705,  408745,  410785,  412824,  414864,  416903,  418943,
+     420982,  423022,  425062,  427101,  429141,  431180,  433220,  435260,
+     437299,  439339,  441378,  443418,  445457,  447497,  449537,  451576,
+     453616,  455655,  457695,  459735,  461774,  463814,  465853,  467893,
+     469932
+};
+
+// Temperature [ 0.01 degC ] at count i * 2^_LUT_TEMPERATURE_SHIFT
+static const int32_t _lutTemperature[ 65 ] =
+{
+      -5000,   -4687,   -4375,   -4062,   -3749,   -3437,   -3124,   -2811,
+      -2499,   -2186,   -1873,   -1561,   -1248,    -936,    -623,    -310,
+          2,     315,     628,     940,    1253,    1566,    1878,    2191,
+       2504,    2816,    3129,    3442,    3754,    4067,    4380,    4692,
+       5005,    5318,    5630,    5943,    6255,    6568,    6881,    7193,
+       7506,    7819,    8131,    8444,    8757,    9069,    9382,    9695,
+      10007,   10320,   10633,   10945,   11258,   11571,   11883,   12196,
+      12509,   12821,   13134,   13447,   13759,   14072,   14384,   14697,
+      15010
+};
+
+#endif